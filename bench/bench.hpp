@@ -0,0 +1,35 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include "types.hpp"
+
+// Micro-benchmarks comparing the vectorized paths to their scalar reference.
+// Built by `make bench` but only meaningful in an optimized build, e.g.
+// `make bench OPT=-O2 ASAN=0 NATIVE=1`. Correctness is covered by the tests.
+
+struct Benchmark
+{
+    const char* name;
+    void (*func)();
+};
+
+std::vector<Benchmark>& benchmarks();
+
+#define BENCHMARK(name)                                                        \
+    static void bench_##name();                                                \
+    static const bool s_##name##_registered =                                  \
+        (benchmarks().push_back({ #name, bench_##name }), true);               \
+    static void bench_##name()
+
+// average nanoseconds per unit of work over `iterations` calls
+template<typename F>
+f64 timeNs(size_t iterations, size_t units_per_call, F&& func)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+        func();
+    std::chrono::duration<f64, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (iterations * units_per_call);
+}
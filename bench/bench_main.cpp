@@ -0,0 +1,25 @@
+#include <cstdio>
+#include <cstring>
+#include "bench.hpp"
+
+std::vector<Benchmark>& benchmarks()
+{
+    static std::vector<Benchmark> list;
+    return list;
+}
+
+// runs every benchmark, or only the ones named on the command line
+s32 main(s32 argc, char** argv)
+{
+    for (auto& bench : benchmarks())
+    {
+        bool selected = argc == 1;
+        for (s32 i = 1; i < argc; i++)
+            selected |= std::strcmp(argv[i], bench.name) == 0;
+
+        if (selected)
+            bench.func();
+    }
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include <cstdio>
+#include <random>
+#include "core/mixer.hpp"
+#include "bench.hpp"
+
+using namespace gbemu::core;
+
+BENCHMARK(mixer)
+{
+    static constexpr size_t BLOCK = 1024;
+    static constexpr size_t BLOCKS = 512;
+
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<s32> dist(0, 15 * 546);
+    std::vector<s16> ch[4];
+    const s16* channels[4];
+    for (size_t i = 0; i < 4; i++)
+    {
+        ch[i].resize(BLOCK);
+        for (auto& s : ch[i])
+            s = dist(rng);
+        channels[i] = ch[i].data();
+    }
+    std::vector<s16> out(BLOCK * 2);
+
+    Mixer mixer;
+    mixer.setRouting(0x77, 0xFF);
+
+    f64 scalar = timeNs(BLOCKS, BLOCK,
+                        [&] { mixer.mixScalar(channels, out.data(), BLOCK); });
+    f64 vector = timeNs(BLOCKS, BLOCK,
+                        [&] { mixer.mix(channels, out.data(), BLOCK); });
+    std::printf("mixer: scalar %.2f ns/sample, vectorized %.2f ns/sample\n",
+                scalar, vector);
+}
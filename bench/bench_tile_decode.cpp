@@ -0,0 +1,55 @@
+#include <cstdio>
+#include <random>
+#include "core/tile_decode.hpp"
+#include "bench.hpp"
+
+using namespace gbemu::core;
+
+BENCHMARK(tile_decode)
+{
+    // a screen worth of tile rows
+    static constexpr size_t ROWS = 20 * 144;
+    static constexpr size_t ITERATIONS = 200;
+
+    std::mt19937 rng(1234);
+    std::vector<u8> tiles(ROWS * 2);
+    for (auto& x : tiles)
+        x = rng();
+
+    u32 palette[16] = { 0xFFFFFFFF, 0xFF555555, 0xFFAAAAAA, 0xFF000000 };
+    std::vector<u32> out(ROWS * 8);
+
+    auto screen = [&](auto&& decode, auto&& apply)
+    {
+        return [&, decode, apply]
+        {
+            for (size_t row = 0; row < ROWS; row++)
+            {
+                u8 codes[8];
+                decode(tiles[row * 2], tiles[row * 2 + 1], codes);
+                apply(codes, palette, &out[row * 8], 8);
+            }
+        };
+    };
+
+    f64 scalar = timeNs(ITERATIONS, ROWS * 8,
+                        screen(decodeTileRowScalar, applyPaletteScalar));
+    f64 vector = timeNs(ITERATIONS, ROWS * 8,
+                        screen(decodeTileRow, applyPalette));
+    std::printf("tile decode: scalar %.2f ns/pixel, vectorized %.2f ns/pixel\n",
+                scalar, vector);
+
+    // whole lines, as drawLine does
+    std::vector<u8> line(160);
+    for (auto& x : line)
+        x = rng() % 12;
+
+    auto scalar_line = [&]
+    { applyPaletteScalar(line.data(), palette, out.data(), line.size()); };
+    auto vector_line = [&]
+    { applyPalette(line.data(), palette, out.data(), line.size()); };
+    scalar = timeNs(ITERATIONS * 144, 1, scalar_line);
+    vector = timeNs(ITERATIONS * 144, 1, vector_line);
+    std::printf("palette: scalar %.2f ns/line, vectorized %.2f ns/line\n",
+                scalar, vector);
+}
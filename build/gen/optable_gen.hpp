@@ -0,0 +1,523 @@
+// generated by tools/optable_gen.py, do not edit
+#pragma once
+// clang-format off
+
+// OPCODE(op, name, size, cycles, cycles_branch, z, n, h, c, operand, disas)
+// ILLEGAL(op)
+#define OPTABLE_UNPREFIXED(OPCODE, ILLEGAL) \
+    OPCODE(0x00, NOP, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "NOP ") \
+    OPCODE(0x01, LD_BC_d16, 3, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM16, "LD BC, ${:04X}") \
+    OPCODE(0x02, LD_MEM_BC_A, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (BC), A") \
+    OPCODE(0x03, INC_BC, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "INC BC") \
+    OPCODE(0x04, INC_B, 1, 4, 4, UPDATE, RESET, UPDATE, KEEP, NONE, "INC B") \
+    OPCODE(0x05, DEC_B, 1, 4, 4, UPDATE, SET, UPDATE, KEEP, NONE, "DEC B") \
+    OPCODE(0x06, LD_B_d8, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, IMM8, "LD B, ${:02X}") \
+    OPCODE(0x07, RLCA, 1, 4, 4, RESET, RESET, RESET, UPDATE, NONE, "RLCA ") \
+    OPCODE(0x08, LD_MEM_a16_SP, 3, 20, 20, KEEP, KEEP, KEEP, KEEP, IMM16, "LD (${:04X}), SP") \
+    OPCODE(0x09, ADD_HL_BC, 1, 8, 8, KEEP, RESET, UPDATE, UPDATE, NONE, "ADD HL, BC") \
+    OPCODE(0x0A, LD_A_MEM_BC, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, (BC)") \
+    OPCODE(0x0B, DEC_BC, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "DEC BC") \
+    OPCODE(0x0C, INC_C, 1, 4, 4, UPDATE, RESET, UPDATE, KEEP, NONE, "INC C") \
+    OPCODE(0x0D, DEC_C, 1, 4, 4, UPDATE, SET, UPDATE, KEEP, NONE, "DEC C") \
+    OPCODE(0x0E, LD_C_d8, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, IMM8, "LD C, ${:02X}") \
+    OPCODE(0x0F, RRCA, 1, 4, 4, RESET, RESET, RESET, UPDATE, NONE, "RRCA ") \
+    OPCODE(0x10, STOP_d8, 2, 4, 4, KEEP, KEEP, KEEP, KEEP, IMM8, "STOP ${:02X}") \
+    OPCODE(0x11, LD_DE_d16, 3, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM16, "LD DE, ${:04X}") \
+    OPCODE(0x12, LD_MEM_DE_A, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (DE), A") \
+    OPCODE(0x13, INC_DE, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "INC DE") \
+    OPCODE(0x14, INC_D, 1, 4, 4, UPDATE, RESET, UPDATE, KEEP, NONE, "INC D") \
+    OPCODE(0x15, DEC_D, 1, 4, 4, UPDATE, SET, UPDATE, KEEP, NONE, "DEC D") \
+    OPCODE(0x16, LD_D_d8, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, IMM8, "LD D, ${:02X}") \
+    OPCODE(0x17, RLA, 1, 4, 4, RESET, RESET, RESET, UPDATE, NONE, "RLA ") \
+    OPCODE(0x18, JR_r8, 2, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "JR ${:02X}") \
+    OPCODE(0x19, ADD_HL_DE, 1, 8, 8, KEEP, RESET, UPDATE, UPDATE, NONE, "ADD HL, DE") \
+    OPCODE(0x1A, LD_A_MEM_DE, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, (DE)") \
+    OPCODE(0x1B, DEC_DE, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "DEC DE") \
+    OPCODE(0x1C, INC_E, 1, 4, 4, UPDATE, RESET, UPDATE, KEEP, NONE, "INC E") \
+    OPCODE(0x1D, DEC_E, 1, 4, 4, UPDATE, SET, UPDATE, KEEP, NONE, "DEC E") \
+    OPCODE(0x1E, LD_E_d8, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, IMM8, "LD E, ${:02X}") \
+    OPCODE(0x1F, RRA, 1, 4, 4, RESET, RESET, RESET, UPDATE, NONE, "RRA ") \
+    OPCODE(0x20, JR_NZ_r8, 2, 8, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "JR NZ, ${:02X}") \
+    OPCODE(0x21, LD_HL_d16, 3, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM16, "LD HL, ${:04X}") \
+    OPCODE(0x22, LD_MEM_HLI_A, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL+), A") \
+    OPCODE(0x23, INC_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "INC HL") \
+    OPCODE(0x24, INC_H, 1, 4, 4, UPDATE, RESET, UPDATE, KEEP, NONE, "INC H") \
+    OPCODE(0x25, DEC_H, 1, 4, 4, UPDATE, SET, UPDATE, KEEP, NONE, "DEC H") \
+    OPCODE(0x26, LD_H_d8, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, IMM8, "LD H, ${:02X}") \
+    OPCODE(0x27, DAA, 1, 4, 4, UPDATE, KEEP, RESET, UPDATE, NONE, "DAA ") \
+    OPCODE(0x28, JR_Z_r8, 2, 8, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "JR Z, ${:02X}") \
+    OPCODE(0x29, ADD_HL_HL, 1, 8, 8, KEEP, RESET, UPDATE, UPDATE, NONE, "ADD HL, HL") \
+    OPCODE(0x2A, LD_A_MEM_HLI, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, (HL+)") \
+    OPCODE(0x2B, DEC_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "DEC HL") \
+    OPCODE(0x2C, INC_L, 1, 4, 4, UPDATE, RESET, UPDATE, KEEP, NONE, "INC L") \
+    OPCODE(0x2D, DEC_L, 1, 4, 4, UPDATE, SET, UPDATE, KEEP, NONE, "DEC L") \
+    OPCODE(0x2E, LD_L_d8, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, IMM8, "LD L, ${:02X}") \
+    OPCODE(0x2F, CPL, 1, 4, 4, KEEP, SET, SET, KEEP, NONE, "CPL ") \
+    OPCODE(0x30, JR_NC_r8, 2, 8, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "JR NC, ${:02X}") \
+    OPCODE(0x31, LD_SP_d16, 3, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM16, "LD SP, ${:04X}") \
+    OPCODE(0x32, LD_MEM_HLD_A, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL-), A") \
+    OPCODE(0x33, INC_SP, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "INC SP") \
+    OPCODE(0x34, INC_MEM_HL, 1, 12, 12, UPDATE, RESET, UPDATE, KEEP, NONE, "INC (HL)") \
+    OPCODE(0x35, DEC_MEM_HL, 1, 12, 12, UPDATE, SET, UPDATE, KEEP, NONE, "DEC (HL)") \
+    OPCODE(0x36, LD_MEM_HL_d8, 2, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "LD (HL), ${:02X}") \
+    OPCODE(0x37, SCF, 1, 4, 4, KEEP, RESET, RESET, SET, NONE, "SCF ") \
+    OPCODE(0x38, JR_C_r8, 2, 8, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "JR C, ${:02X}") \
+    OPCODE(0x39, ADD_HL_SP, 1, 8, 8, KEEP, RESET, UPDATE, UPDATE, NONE, "ADD HL, SP") \
+    OPCODE(0x3A, LD_A_MEM_HLD, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, (HL-)") \
+    OPCODE(0x3B, DEC_SP, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "DEC SP") \
+    OPCODE(0x3C, INC_A, 1, 4, 4, UPDATE, RESET, UPDATE, KEEP, NONE, "INC A") \
+    OPCODE(0x3D, DEC_A, 1, 4, 4, UPDATE, SET, UPDATE, KEEP, NONE, "DEC A") \
+    OPCODE(0x3E, LD_A_d8, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, IMM8, "LD A, ${:02X}") \
+    OPCODE(0x3F, CCF, 1, 4, 4, KEEP, RESET, RESET, UPDATE, NONE, "CCF ") \
+    OPCODE(0x40, LD_B_B, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, B") \
+    OPCODE(0x41, LD_B_C, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, C") \
+    OPCODE(0x42, LD_B_D, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, D") \
+    OPCODE(0x43, LD_B_E, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, E") \
+    OPCODE(0x44, LD_B_H, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, H") \
+    OPCODE(0x45, LD_B_L, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, L") \
+    OPCODE(0x46, LD_B_MEM_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, (HL)") \
+    OPCODE(0x47, LD_B_A, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD B, A") \
+    OPCODE(0x48, LD_C_B, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, B") \
+    OPCODE(0x49, LD_C_C, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, C") \
+    OPCODE(0x4A, LD_C_D, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, D") \
+    OPCODE(0x4B, LD_C_E, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, E") \
+    OPCODE(0x4C, LD_C_H, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, H") \
+    OPCODE(0x4D, LD_C_L, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, L") \
+    OPCODE(0x4E, LD_C_MEM_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, (HL)") \
+    OPCODE(0x4F, LD_C_A, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD C, A") \
+    OPCODE(0x50, LD_D_B, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, B") \
+    OPCODE(0x51, LD_D_C, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, C") \
+    OPCODE(0x52, LD_D_D, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, D") \
+    OPCODE(0x53, LD_D_E, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, E") \
+    OPCODE(0x54, LD_D_H, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, H") \
+    OPCODE(0x55, LD_D_L, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, L") \
+    OPCODE(0x56, LD_D_MEM_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, (HL)") \
+    OPCODE(0x57, LD_D_A, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD D, A") \
+    OPCODE(0x58, LD_E_B, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, B") \
+    OPCODE(0x59, LD_E_C, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, C") \
+    OPCODE(0x5A, LD_E_D, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, D") \
+    OPCODE(0x5B, LD_E_E, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, E") \
+    OPCODE(0x5C, LD_E_H, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, H") \
+    OPCODE(0x5D, LD_E_L, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, L") \
+    OPCODE(0x5E, LD_E_MEM_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, (HL)") \
+    OPCODE(0x5F, LD_E_A, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD E, A") \
+    OPCODE(0x60, LD_H_B, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, B") \
+    OPCODE(0x61, LD_H_C, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, C") \
+    OPCODE(0x62, LD_H_D, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, D") \
+    OPCODE(0x63, LD_H_E, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, E") \
+    OPCODE(0x64, LD_H_H, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, H") \
+    OPCODE(0x65, LD_H_L, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, L") \
+    OPCODE(0x66, LD_H_MEM_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, (HL)") \
+    OPCODE(0x67, LD_H_A, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD H, A") \
+    OPCODE(0x68, LD_L_B, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, B") \
+    OPCODE(0x69, LD_L_C, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, C") \
+    OPCODE(0x6A, LD_L_D, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, D") \
+    OPCODE(0x6B, LD_L_E, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, E") \
+    OPCODE(0x6C, LD_L_H, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, H") \
+    OPCODE(0x6D, LD_L_L, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, L") \
+    OPCODE(0x6E, LD_L_MEM_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, (HL)") \
+    OPCODE(0x6F, LD_L_A, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD L, A") \
+    OPCODE(0x70, LD_MEM_HL_B, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL), B") \
+    OPCODE(0x71, LD_MEM_HL_C, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL), C") \
+    OPCODE(0x72, LD_MEM_HL_D, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL), D") \
+    OPCODE(0x73, LD_MEM_HL_E, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL), E") \
+    OPCODE(0x74, LD_MEM_HL_H, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL), H") \
+    OPCODE(0x75, LD_MEM_HL_L, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL), L") \
+    OPCODE(0x76, HALT, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "HALT ") \
+    OPCODE(0x77, LD_MEM_HL_A, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (HL), A") \
+    OPCODE(0x78, LD_A_B, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, B") \
+    OPCODE(0x79, LD_A_C, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, C") \
+    OPCODE(0x7A, LD_A_D, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, D") \
+    OPCODE(0x7B, LD_A_E, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, E") \
+    OPCODE(0x7C, LD_A_H, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, H") \
+    OPCODE(0x7D, LD_A_L, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, L") \
+    OPCODE(0x7E, LD_A_MEM_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, (HL)") \
+    OPCODE(0x7F, LD_A_A, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, A") \
+    OPCODE(0x80, ADD_A_B, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, B") \
+    OPCODE(0x81, ADD_A_C, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, C") \
+    OPCODE(0x82, ADD_A_D, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, D") \
+    OPCODE(0x83, ADD_A_E, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, E") \
+    OPCODE(0x84, ADD_A_H, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, H") \
+    OPCODE(0x85, ADD_A_L, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, L") \
+    OPCODE(0x86, ADD_A_MEM_HL, 1, 8, 8, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, (HL)") \
+    OPCODE(0x87, ADD_A_A, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADD A, A") \
+    OPCODE(0x88, ADC_A_B, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, B") \
+    OPCODE(0x89, ADC_A_C, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, C") \
+    OPCODE(0x8A, ADC_A_D, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, D") \
+    OPCODE(0x8B, ADC_A_E, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, E") \
+    OPCODE(0x8C, ADC_A_H, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, H") \
+    OPCODE(0x8D, ADC_A_L, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, L") \
+    OPCODE(0x8E, ADC_A_MEM_HL, 1, 8, 8, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, (HL)") \
+    OPCODE(0x8F, ADC_A_A, 1, 4, 4, UPDATE, RESET, UPDATE, UPDATE, NONE, "ADC A, A") \
+    OPCODE(0x90, SUB_B, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SUB B") \
+    OPCODE(0x91, SUB_C, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SUB C") \
+    OPCODE(0x92, SUB_D, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SUB D") \
+    OPCODE(0x93, SUB_E, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SUB E") \
+    OPCODE(0x94, SUB_H, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SUB H") \
+    OPCODE(0x95, SUB_L, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SUB L") \
+    OPCODE(0x96, SUB_MEM_HL, 1, 8, 8, UPDATE, SET, UPDATE, UPDATE, NONE, "SUB (HL)") \
+    OPCODE(0x97, SUB_A, 1, 4, 4, SET, SET, RESET, RESET, NONE, "SUB A") \
+    OPCODE(0x98, SBC_A_B, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, B") \
+    OPCODE(0x99, SBC_A_C, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, C") \
+    OPCODE(0x9A, SBC_A_D, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, D") \
+    OPCODE(0x9B, SBC_A_E, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, E") \
+    OPCODE(0x9C, SBC_A_H, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, H") \
+    OPCODE(0x9D, SBC_A_L, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, L") \
+    OPCODE(0x9E, SBC_A_MEM_HL, 1, 8, 8, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, (HL)") \
+    OPCODE(0x9F, SBC_A_A, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "SBC A, A") \
+    OPCODE(0xA0, AND_B, 1, 4, 4, UPDATE, RESET, SET, RESET, NONE, "AND B") \
+    OPCODE(0xA1, AND_C, 1, 4, 4, UPDATE, RESET, SET, RESET, NONE, "AND C") \
+    OPCODE(0xA2, AND_D, 1, 4, 4, UPDATE, RESET, SET, RESET, NONE, "AND D") \
+    OPCODE(0xA3, AND_E, 1, 4, 4, UPDATE, RESET, SET, RESET, NONE, "AND E") \
+    OPCODE(0xA4, AND_H, 1, 4, 4, UPDATE, RESET, SET, RESET, NONE, "AND H") \
+    OPCODE(0xA5, AND_L, 1, 4, 4, UPDATE, RESET, SET, RESET, NONE, "AND L") \
+    OPCODE(0xA6, AND_MEM_HL, 1, 8, 8, UPDATE, RESET, SET, RESET, NONE, "AND (HL)") \
+    OPCODE(0xA7, AND_A, 1, 4, 4, UPDATE, RESET, SET, RESET, NONE, "AND A") \
+    OPCODE(0xA8, XOR_B, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "XOR B") \
+    OPCODE(0xA9, XOR_C, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "XOR C") \
+    OPCODE(0xAA, XOR_D, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "XOR D") \
+    OPCODE(0xAB, XOR_E, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "XOR E") \
+    OPCODE(0xAC, XOR_H, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "XOR H") \
+    OPCODE(0xAD, XOR_L, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "XOR L") \
+    OPCODE(0xAE, XOR_MEM_HL, 1, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "XOR (HL)") \
+    OPCODE(0xAF, XOR_A, 1, 4, 4, SET, RESET, RESET, RESET, NONE, "XOR A") \
+    OPCODE(0xB0, OR_B, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "OR B") \
+    OPCODE(0xB1, OR_C, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "OR C") \
+    OPCODE(0xB2, OR_D, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "OR D") \
+    OPCODE(0xB3, OR_E, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "OR E") \
+    OPCODE(0xB4, OR_H, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "OR H") \
+    OPCODE(0xB5, OR_L, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "OR L") \
+    OPCODE(0xB6, OR_MEM_HL, 1, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "OR (HL)") \
+    OPCODE(0xB7, OR_A, 1, 4, 4, UPDATE, RESET, RESET, RESET, NONE, "OR A") \
+    OPCODE(0xB8, CP_B, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "CP B") \
+    OPCODE(0xB9, CP_C, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "CP C") \
+    OPCODE(0xBA, CP_D, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "CP D") \
+    OPCODE(0xBB, CP_E, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "CP E") \
+    OPCODE(0xBC, CP_H, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "CP H") \
+    OPCODE(0xBD, CP_L, 1, 4, 4, UPDATE, SET, UPDATE, UPDATE, NONE, "CP L") \
+    OPCODE(0xBE, CP_MEM_HL, 1, 8, 8, UPDATE, SET, UPDATE, UPDATE, NONE, "CP (HL)") \
+    OPCODE(0xBF, CP_A, 1, 4, 4, SET, SET, RESET, RESET, NONE, "CP A") \
+    OPCODE(0xC0, RET_NZ, 1, 8, 20, KEEP, KEEP, KEEP, KEEP, NONE, "RET NZ") \
+    OPCODE(0xC1, POP_BC, 1, 12, 12, KEEP, KEEP, KEEP, KEEP, NONE, "POP BC") \
+    OPCODE(0xC2, JP_NZ_a16, 3, 12, 16, KEEP, KEEP, KEEP, KEEP, IMM16, "JP NZ, ${:04X}") \
+    OPCODE(0xC3, JP_a16, 3, 16, 16, KEEP, KEEP, KEEP, KEEP, IMM16, "JP ${:04X}") \
+    OPCODE(0xC4, CALL_NZ_a16, 3, 12, 24, KEEP, KEEP, KEEP, KEEP, IMM16, "CALL NZ, ${:04X}") \
+    OPCODE(0xC5, PUSH_BC, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "PUSH BC") \
+    OPCODE(0xC6, ADD_A_d8, 2, 8, 8, UPDATE, RESET, UPDATE, UPDATE, IMM8, "ADD A, ${:02X}") \
+    OPCODE(0xC7, RST_00H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 00H") \
+    OPCODE(0xC8, RET_Z, 1, 8, 20, KEEP, KEEP, KEEP, KEEP, NONE, "RET Z") \
+    OPCODE(0xC9, RET, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RET ") \
+    OPCODE(0xCA, JP_Z_a16, 3, 12, 16, KEEP, KEEP, KEEP, KEEP, IMM16, "JP Z, ${:04X}") \
+    OPCODE(0xCB, PREFIX, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "PREFIX ") \
+    OPCODE(0xCC, CALL_Z_a16, 3, 12, 24, KEEP, KEEP, KEEP, KEEP, IMM16, "CALL Z, ${:04X}") \
+    OPCODE(0xCD, CALL_a16, 3, 24, 24, KEEP, KEEP, KEEP, KEEP, IMM16, "CALL ${:04X}") \
+    OPCODE(0xCE, ADC_A_d8, 2, 8, 8, UPDATE, RESET, UPDATE, UPDATE, IMM8, "ADC A, ${:02X}") \
+    OPCODE(0xCF, RST_08H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 08H") \
+    OPCODE(0xD0, RET_NC, 1, 8, 20, KEEP, KEEP, KEEP, KEEP, NONE, "RET NC") \
+    OPCODE(0xD1, POP_DE, 1, 12, 12, KEEP, KEEP, KEEP, KEEP, NONE, "POP DE") \
+    OPCODE(0xD2, JP_NC_a16, 3, 12, 16, KEEP, KEEP, KEEP, KEEP, IMM16, "JP NC, ${:04X}") \
+    ILLEGAL(0xD3) \
+    OPCODE(0xD4, CALL_NC_a16, 3, 12, 24, KEEP, KEEP, KEEP, KEEP, IMM16, "CALL NC, ${:04X}") \
+    OPCODE(0xD5, PUSH_DE, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "PUSH DE") \
+    OPCODE(0xD6, SUB_d8, 2, 8, 8, UPDATE, SET, UPDATE, UPDATE, IMM8, "SUB ${:02X}") \
+    OPCODE(0xD7, RST_10H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 10H") \
+    OPCODE(0xD8, RET_C, 1, 8, 20, KEEP, KEEP, KEEP, KEEP, NONE, "RET C") \
+    OPCODE(0xD9, RETI, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RETI ") \
+    OPCODE(0xDA, JP_C_a16, 3, 12, 16, KEEP, KEEP, KEEP, KEEP, IMM16, "JP C, ${:04X}") \
+    ILLEGAL(0xDB) \
+    OPCODE(0xDC, CALL_C_a16, 3, 12, 24, KEEP, KEEP, KEEP, KEEP, IMM16, "CALL C, ${:04X}") \
+    ILLEGAL(0xDD) \
+    OPCODE(0xDE, SBC_A_d8, 2, 8, 8, UPDATE, SET, UPDATE, UPDATE, IMM8, "SBC A, ${:02X}") \
+    OPCODE(0xDF, RST_18H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 18H") \
+    OPCODE(0xE0, LDH_MEM_a8_A, 2, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "LDH (${:02X}), A") \
+    OPCODE(0xE1, POP_HL, 1, 12, 12, KEEP, KEEP, KEEP, KEEP, NONE, "POP HL") \
+    OPCODE(0xE2, LD_MEM_C_A, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD (C), A") \
+    ILLEGAL(0xE3) \
+    ILLEGAL(0xE4) \
+    OPCODE(0xE5, PUSH_HL, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "PUSH HL") \
+    OPCODE(0xE6, AND_d8, 2, 8, 8, UPDATE, RESET, SET, RESET, IMM8, "AND ${:02X}") \
+    OPCODE(0xE7, RST_20H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 20H") \
+    OPCODE(0xE8, ADD_SP_r8, 2, 16, 16, RESET, RESET, UPDATE, UPDATE, IMM8, "ADD SP, ${:02X}") \
+    OPCODE(0xE9, JP_HL, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "JP HL") \
+    OPCODE(0xEA, LD_MEM_a16_A, 3, 16, 16, KEEP, KEEP, KEEP, KEEP, IMM16, "LD (${:04X}), A") \
+    ILLEGAL(0xEB) \
+    ILLEGAL(0xEC) \
+    ILLEGAL(0xED) \
+    OPCODE(0xEE, XOR_d8, 2, 8, 8, UPDATE, RESET, RESET, RESET, IMM8, "XOR ${:02X}") \
+    OPCODE(0xEF, RST_28H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 28H") \
+    OPCODE(0xF0, LDH_A_MEM_a8, 2, 12, 12, KEEP, KEEP, KEEP, KEEP, IMM8, "LDH A, (${:02X})") \
+    OPCODE(0xF1, POP_AF, 1, 12, 12, UPDATE, UPDATE, UPDATE, UPDATE, NONE, "POP AF") \
+    OPCODE(0xF2, LD_A_MEM_C, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD A, (C)") \
+    OPCODE(0xF3, DI, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "DI ") \
+    ILLEGAL(0xF4) \
+    OPCODE(0xF5, PUSH_AF, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "PUSH AF") \
+    OPCODE(0xF6, OR_d8, 2, 8, 8, UPDATE, RESET, RESET, RESET, IMM8, "OR ${:02X}") \
+    OPCODE(0xF7, RST_30H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 30H") \
+    OPCODE(0xF8, LD_HL_SPI_r8, 2, 12, 12, RESET, RESET, UPDATE, UPDATE, IMM8, "LD HL, SP+${:02X}") \
+    OPCODE(0xF9, LD_SP_HL, 1, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "LD SP, HL") \
+    OPCODE(0xFA, LD_A_MEM_a16, 3, 16, 16, KEEP, KEEP, KEEP, KEEP, IMM16, "LD A, (${:04X})") \
+    OPCODE(0xFB, EI, 1, 4, 4, KEEP, KEEP, KEEP, KEEP, NONE, "EI ") \
+    ILLEGAL(0xFC) \
+    ILLEGAL(0xFD) \
+    OPCODE(0xFE, CP_d8, 2, 8, 8, UPDATE, SET, UPDATE, UPDATE, IMM8, "CP ${:02X}") \
+    OPCODE(0xFF, RST_38H, 1, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RST 38H") \
+
+#define OPTABLE_CBPREFIXED(OPCODE) \
+    OPCODE(0x00, RLC_B, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RLC B") \
+    OPCODE(0x01, RLC_C, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RLC C") \
+    OPCODE(0x02, RLC_D, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RLC D") \
+    OPCODE(0x03, RLC_E, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RLC E") \
+    OPCODE(0x04, RLC_H, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RLC H") \
+    OPCODE(0x05, RLC_L, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RLC L") \
+    OPCODE(0x06, RLC_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, UPDATE, NONE, "RLC (HL)") \
+    OPCODE(0x07, RLC_A, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RLC A") \
+    OPCODE(0x08, RRC_B, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RRC B") \
+    OPCODE(0x09, RRC_C, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RRC C") \
+    OPCODE(0x0A, RRC_D, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RRC D") \
+    OPCODE(0x0B, RRC_E, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RRC E") \
+    OPCODE(0x0C, RRC_H, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RRC H") \
+    OPCODE(0x0D, RRC_L, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RRC L") \
+    OPCODE(0x0E, RRC_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, UPDATE, NONE, "RRC (HL)") \
+    OPCODE(0x0F, RRC_A, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RRC A") \
+    OPCODE(0x10, RL_B, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RL B") \
+    OPCODE(0x11, RL_C, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RL C") \
+    OPCODE(0x12, RL_D, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RL D") \
+    OPCODE(0x13, RL_E, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RL E") \
+    OPCODE(0x14, RL_H, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RL H") \
+    OPCODE(0x15, RL_L, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RL L") \
+    OPCODE(0x16, RL_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, UPDATE, NONE, "RL (HL)") \
+    OPCODE(0x17, RL_A, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RL A") \
+    OPCODE(0x18, RR_B, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RR B") \
+    OPCODE(0x19, RR_C, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RR C") \
+    OPCODE(0x1A, RR_D, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RR D") \
+    OPCODE(0x1B, RR_E, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RR E") \
+    OPCODE(0x1C, RR_H, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RR H") \
+    OPCODE(0x1D, RR_L, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RR L") \
+    OPCODE(0x1E, RR_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, UPDATE, NONE, "RR (HL)") \
+    OPCODE(0x1F, RR_A, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "RR A") \
+    OPCODE(0x20, SLA_B, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SLA B") \
+    OPCODE(0x21, SLA_C, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SLA C") \
+    OPCODE(0x22, SLA_D, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SLA D") \
+    OPCODE(0x23, SLA_E, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SLA E") \
+    OPCODE(0x24, SLA_H, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SLA H") \
+    OPCODE(0x25, SLA_L, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SLA L") \
+    OPCODE(0x26, SLA_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, UPDATE, NONE, "SLA (HL)") \
+    OPCODE(0x27, SLA_A, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SLA A") \
+    OPCODE(0x28, SRA_B, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRA B") \
+    OPCODE(0x29, SRA_C, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRA C") \
+    OPCODE(0x2A, SRA_D, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRA D") \
+    OPCODE(0x2B, SRA_E, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRA E") \
+    OPCODE(0x2C, SRA_H, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRA H") \
+    OPCODE(0x2D, SRA_L, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRA L") \
+    OPCODE(0x2E, SRA_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, UPDATE, NONE, "SRA (HL)") \
+    OPCODE(0x2F, SRA_A, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRA A") \
+    OPCODE(0x30, SWAP_B, 2, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "SWAP B") \
+    OPCODE(0x31, SWAP_C, 2, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "SWAP C") \
+    OPCODE(0x32, SWAP_D, 2, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "SWAP D") \
+    OPCODE(0x33, SWAP_E, 2, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "SWAP E") \
+    OPCODE(0x34, SWAP_H, 2, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "SWAP H") \
+    OPCODE(0x35, SWAP_L, 2, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "SWAP L") \
+    OPCODE(0x36, SWAP_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, RESET, NONE, "SWAP (HL)") \
+    OPCODE(0x37, SWAP_A, 2, 8, 8, UPDATE, RESET, RESET, RESET, NONE, "SWAP A") \
+    OPCODE(0x38, SRL_B, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRL B") \
+    OPCODE(0x39, SRL_C, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRL C") \
+    OPCODE(0x3A, SRL_D, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRL D") \
+    OPCODE(0x3B, SRL_E, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRL E") \
+    OPCODE(0x3C, SRL_H, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRL H") \
+    OPCODE(0x3D, SRL_L, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRL L") \
+    OPCODE(0x3E, SRL_MEM_HL, 2, 16, 16, UPDATE, RESET, RESET, UPDATE, NONE, "SRL (HL)") \
+    OPCODE(0x3F, SRL_A, 2, 8, 8, UPDATE, RESET, RESET, UPDATE, NONE, "SRL A") \
+    OPCODE(0x40, BIT_0_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, B") \
+    OPCODE(0x41, BIT_0_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, C") \
+    OPCODE(0x42, BIT_0_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, D") \
+    OPCODE(0x43, BIT_0_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, E") \
+    OPCODE(0x44, BIT_0_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, H") \
+    OPCODE(0x45, BIT_0_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, L") \
+    OPCODE(0x46, BIT_0_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, (HL)") \
+    OPCODE(0x47, BIT_0_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 0, A") \
+    OPCODE(0x48, BIT_1_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, B") \
+    OPCODE(0x49, BIT_1_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, C") \
+    OPCODE(0x4A, BIT_1_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, D") \
+    OPCODE(0x4B, BIT_1_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, E") \
+    OPCODE(0x4C, BIT_1_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, H") \
+    OPCODE(0x4D, BIT_1_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, L") \
+    OPCODE(0x4E, BIT_1_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, (HL)") \
+    OPCODE(0x4F, BIT_1_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 1, A") \
+    OPCODE(0x50, BIT_2_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, B") \
+    OPCODE(0x51, BIT_2_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, C") \
+    OPCODE(0x52, BIT_2_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, D") \
+    OPCODE(0x53, BIT_2_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, E") \
+    OPCODE(0x54, BIT_2_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, H") \
+    OPCODE(0x55, BIT_2_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, L") \
+    OPCODE(0x56, BIT_2_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, (HL)") \
+    OPCODE(0x57, BIT_2_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 2, A") \
+    OPCODE(0x58, BIT_3_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, B") \
+    OPCODE(0x59, BIT_3_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, C") \
+    OPCODE(0x5A, BIT_3_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, D") \
+    OPCODE(0x5B, BIT_3_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, E") \
+    OPCODE(0x5C, BIT_3_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, H") \
+    OPCODE(0x5D, BIT_3_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, L") \
+    OPCODE(0x5E, BIT_3_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, (HL)") \
+    OPCODE(0x5F, BIT_3_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 3, A") \
+    OPCODE(0x60, BIT_4_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, B") \
+    OPCODE(0x61, BIT_4_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, C") \
+    OPCODE(0x62, BIT_4_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, D") \
+    OPCODE(0x63, BIT_4_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, E") \
+    OPCODE(0x64, BIT_4_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, H") \
+    OPCODE(0x65, BIT_4_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, L") \
+    OPCODE(0x66, BIT_4_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, (HL)") \
+    OPCODE(0x67, BIT_4_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 4, A") \
+    OPCODE(0x68, BIT_5_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, B") \
+    OPCODE(0x69, BIT_5_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, C") \
+    OPCODE(0x6A, BIT_5_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, D") \
+    OPCODE(0x6B, BIT_5_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, E") \
+    OPCODE(0x6C, BIT_5_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, H") \
+    OPCODE(0x6D, BIT_5_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, L") \
+    OPCODE(0x6E, BIT_5_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, (HL)") \
+    OPCODE(0x6F, BIT_5_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 5, A") \
+    OPCODE(0x70, BIT_6_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, B") \
+    OPCODE(0x71, BIT_6_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, C") \
+    OPCODE(0x72, BIT_6_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, D") \
+    OPCODE(0x73, BIT_6_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, E") \
+    OPCODE(0x74, BIT_6_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, H") \
+    OPCODE(0x75, BIT_6_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, L") \
+    OPCODE(0x76, BIT_6_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, (HL)") \
+    OPCODE(0x77, BIT_6_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 6, A") \
+    OPCODE(0x78, BIT_7_B, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, B") \
+    OPCODE(0x79, BIT_7_C, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, C") \
+    OPCODE(0x7A, BIT_7_D, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, D") \
+    OPCODE(0x7B, BIT_7_E, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, E") \
+    OPCODE(0x7C, BIT_7_H, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, H") \
+    OPCODE(0x7D, BIT_7_L, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, L") \
+    OPCODE(0x7E, BIT_7_MEM_HL, 2, 12, 12, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, (HL)") \
+    OPCODE(0x7F, BIT_7_A, 2, 8, 8, UPDATE, RESET, SET, KEEP, NONE, "BIT 7, A") \
+    OPCODE(0x80, RES_0_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, B") \
+    OPCODE(0x81, RES_0_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, C") \
+    OPCODE(0x82, RES_0_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, D") \
+    OPCODE(0x83, RES_0_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, E") \
+    OPCODE(0x84, RES_0_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, H") \
+    OPCODE(0x85, RES_0_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, L") \
+    OPCODE(0x86, RES_0_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, (HL)") \
+    OPCODE(0x87, RES_0_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 0, A") \
+    OPCODE(0x88, RES_1_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, B") \
+    OPCODE(0x89, RES_1_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, C") \
+    OPCODE(0x8A, RES_1_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, D") \
+    OPCODE(0x8B, RES_1_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, E") \
+    OPCODE(0x8C, RES_1_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, H") \
+    OPCODE(0x8D, RES_1_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, L") \
+    OPCODE(0x8E, RES_1_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, (HL)") \
+    OPCODE(0x8F, RES_1_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 1, A") \
+    OPCODE(0x90, RES_2_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, B") \
+    OPCODE(0x91, RES_2_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, C") \
+    OPCODE(0x92, RES_2_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, D") \
+    OPCODE(0x93, RES_2_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, E") \
+    OPCODE(0x94, RES_2_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, H") \
+    OPCODE(0x95, RES_2_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, L") \
+    OPCODE(0x96, RES_2_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, (HL)") \
+    OPCODE(0x97, RES_2_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 2, A") \
+    OPCODE(0x98, RES_3_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, B") \
+    OPCODE(0x99, RES_3_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, C") \
+    OPCODE(0x9A, RES_3_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, D") \
+    OPCODE(0x9B, RES_3_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, E") \
+    OPCODE(0x9C, RES_3_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, H") \
+    OPCODE(0x9D, RES_3_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, L") \
+    OPCODE(0x9E, RES_3_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, (HL)") \
+    OPCODE(0x9F, RES_3_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 3, A") \
+    OPCODE(0xA0, RES_4_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, B") \
+    OPCODE(0xA1, RES_4_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, C") \
+    OPCODE(0xA2, RES_4_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, D") \
+    OPCODE(0xA3, RES_4_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, E") \
+    OPCODE(0xA4, RES_4_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, H") \
+    OPCODE(0xA5, RES_4_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, L") \
+    OPCODE(0xA6, RES_4_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, (HL)") \
+    OPCODE(0xA7, RES_4_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 4, A") \
+    OPCODE(0xA8, RES_5_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, B") \
+    OPCODE(0xA9, RES_5_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, C") \
+    OPCODE(0xAA, RES_5_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, D") \
+    OPCODE(0xAB, RES_5_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, E") \
+    OPCODE(0xAC, RES_5_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, H") \
+    OPCODE(0xAD, RES_5_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, L") \
+    OPCODE(0xAE, RES_5_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, (HL)") \
+    OPCODE(0xAF, RES_5_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 5, A") \
+    OPCODE(0xB0, RES_6_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, B") \
+    OPCODE(0xB1, RES_6_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, C") \
+    OPCODE(0xB2, RES_6_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, D") \
+    OPCODE(0xB3, RES_6_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, E") \
+    OPCODE(0xB4, RES_6_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, H") \
+    OPCODE(0xB5, RES_6_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, L") \
+    OPCODE(0xB6, RES_6_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, (HL)") \
+    OPCODE(0xB7, RES_6_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 6, A") \
+    OPCODE(0xB8, RES_7_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, B") \
+    OPCODE(0xB9, RES_7_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, C") \
+    OPCODE(0xBA, RES_7_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, D") \
+    OPCODE(0xBB, RES_7_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, E") \
+    OPCODE(0xBC, RES_7_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, H") \
+    OPCODE(0xBD, RES_7_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, L") \
+    OPCODE(0xBE, RES_7_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, (HL)") \
+    OPCODE(0xBF, RES_7_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "RES 7, A") \
+    OPCODE(0xC0, SET_0_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, B") \
+    OPCODE(0xC1, SET_0_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, C") \
+    OPCODE(0xC2, SET_0_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, D") \
+    OPCODE(0xC3, SET_0_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, E") \
+    OPCODE(0xC4, SET_0_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, H") \
+    OPCODE(0xC5, SET_0_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, L") \
+    OPCODE(0xC6, SET_0_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, (HL)") \
+    OPCODE(0xC7, SET_0_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 0, A") \
+    OPCODE(0xC8, SET_1_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, B") \
+    OPCODE(0xC9, SET_1_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, C") \
+    OPCODE(0xCA, SET_1_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, D") \
+    OPCODE(0xCB, SET_1_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, E") \
+    OPCODE(0xCC, SET_1_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, H") \
+    OPCODE(0xCD, SET_1_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, L") \
+    OPCODE(0xCE, SET_1_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, (HL)") \
+    OPCODE(0xCF, SET_1_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 1, A") \
+    OPCODE(0xD0, SET_2_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, B") \
+    OPCODE(0xD1, SET_2_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, C") \
+    OPCODE(0xD2, SET_2_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, D") \
+    OPCODE(0xD3, SET_2_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, E") \
+    OPCODE(0xD4, SET_2_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, H") \
+    OPCODE(0xD5, SET_2_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, L") \
+    OPCODE(0xD6, SET_2_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, (HL)") \
+    OPCODE(0xD7, SET_2_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 2, A") \
+    OPCODE(0xD8, SET_3_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, B") \
+    OPCODE(0xD9, SET_3_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, C") \
+    OPCODE(0xDA, SET_3_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, D") \
+    OPCODE(0xDB, SET_3_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, E") \
+    OPCODE(0xDC, SET_3_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, H") \
+    OPCODE(0xDD, SET_3_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, L") \
+    OPCODE(0xDE, SET_3_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, (HL)") \
+    OPCODE(0xDF, SET_3_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 3, A") \
+    OPCODE(0xE0, SET_4_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, B") \
+    OPCODE(0xE1, SET_4_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, C") \
+    OPCODE(0xE2, SET_4_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, D") \
+    OPCODE(0xE3, SET_4_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, E") \
+    OPCODE(0xE4, SET_4_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, H") \
+    OPCODE(0xE5, SET_4_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, L") \
+    OPCODE(0xE6, SET_4_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, (HL)") \
+    OPCODE(0xE7, SET_4_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 4, A") \
+    OPCODE(0xE8, SET_5_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, B") \
+    OPCODE(0xE9, SET_5_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, C") \
+    OPCODE(0xEA, SET_5_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, D") \
+    OPCODE(0xEB, SET_5_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, E") \
+    OPCODE(0xEC, SET_5_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, H") \
+    OPCODE(0xED, SET_5_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, L") \
+    OPCODE(0xEE, SET_5_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, (HL)") \
+    OPCODE(0xEF, SET_5_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 5, A") \
+    OPCODE(0xF0, SET_6_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, B") \
+    OPCODE(0xF1, SET_6_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, C") \
+    OPCODE(0xF2, SET_6_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, D") \
+    OPCODE(0xF3, SET_6_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, E") \
+    OPCODE(0xF4, SET_6_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, H") \
+    OPCODE(0xF5, SET_6_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, L") \
+    OPCODE(0xF6, SET_6_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, (HL)") \
+    OPCODE(0xF7, SET_6_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 6, A") \
+    OPCODE(0xF8, SET_7_B, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, B") \
+    OPCODE(0xF9, SET_7_C, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, C") \
+    OPCODE(0xFA, SET_7_D, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, D") \
+    OPCODE(0xFB, SET_7_E, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, E") \
+    OPCODE(0xFC, SET_7_H, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, H") \
+    OPCODE(0xFD, SET_7_L, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, L") \
+    OPCODE(0xFE, SET_7_MEM_HL, 2, 16, 16, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, (HL)") \
+    OPCODE(0xFF, SET_7_A, 2, 8, 8, KEEP, KEEP, KEEP, KEEP, NONE, "SET 7, A") \
+
+// clang-format on
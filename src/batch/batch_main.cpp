@@ -0,0 +1,391 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string_view>
+#include "types.hpp"
+#include "common/arg_parser.hpp"
+#include "common/fs.hpp"
+#include "common/logging.hpp"
+#include "common/thread_pool.hpp"
+#include "core/apu.hpp"
+#include "core/capture_sink.hpp"
+#include "core/cart.hpp"
+#include "core/cpu.hpp"
+#include "core/gameboy.hpp"
+#include "core/io.hpp"
+#include "core/joypad.hpp"
+#include "core/ppu.hpp"
+#include "core/timer.hpp"
+
+// Runs every job of a manifest on its own Gameboy, spread over all cores.
+//
+// The manifest has one job per line, made of space separated key=value
+// fields ('#' starts a comment). Paths are relative to the manifest.
+//   rom=<path>      cartridge, required
+//   bootrom=<path>  bootrom to start from
+//   movie=<path>    input movie
+//   frames=<n>      number of frames to run (600 by default)
+//   cycles=<n>      T-state budget, the job stops at whichever comes first
+//   audio=<path>    streams the audio to a .wav or .raw file
+//   state=<path>    writes a save state once the job is over
+//
+// Input movies have one "<frame> <buttons>" pair per line, the buttons being
+// a JoypadButton mask (e.g. 0x80 for Start) held from that frame until the
+// next line.
+//
+// Each ROM and bootrom is loaded once and shared by every job using it. Jobs
+// never touch the cartridge save files.
+
+using namespace gbemu::core;
+
+static constexpr u32 DEFAULT_FRAME_COUNT = 600;
+
+struct MovieInput
+{
+    u32 frame;
+    u8 buttons;
+};
+
+struct Job
+{
+    std::string name;
+    fs::path rom;
+    fs::path bootrom;
+    fs::path movie;
+    fs::path audio;
+    fs::path state;
+    u32 frames;
+    u64 cycles;
+};
+
+struct JobResult
+{
+    std::string error; // empty on success
+    u32 frames;
+    u64 clocks;
+    f64 seconds;
+    u64 frame_hash; // last frame drawn
+};
+
+template<typename T>
+static bool parseNumber(std::string_view str, T& value)
+{
+    s32 base = 10;
+    if (str.starts_with("0x"))
+    {
+        str.remove_prefix(2);
+        base = 16;
+    }
+
+    auto end = str.data() + str.size();
+    auto ret = std::from_chars(str.data(), end, value, base);
+    return ret.ec == std::errc() && ret.ptr == end && !str.empty();
+}
+
+static bool parseManifest(const fs::path& path, std::vector<Job>& jobs)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        LOG_ERROR("Could not open {}\n", path.string());
+        return false;
+    }
+
+    auto dir = path.parent_path();
+    std::string line;
+    for (size_t line_num = 1; std::getline(file, line); line_num++)
+    {
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos)
+            continue;
+
+        Job job = {};
+        bool has_frames = false;
+        bool has_cycles = false;
+
+        std::istringstream fields(line);
+        std::string field;
+        while (fields >> field)
+        {
+            auto sep = field.find('=');
+            auto key = field.substr(0, sep);
+            auto value = sep == std::string::npos ? "" : field.substr(sep + 1);
+            bool valid = !value.empty();
+
+            if (key == "rom")
+                job.rom = dir / value;
+            else if (key == "bootrom")
+                job.bootrom = dir / value;
+            else if (key == "movie")
+                job.movie = dir / value;
+            else if (key == "audio")
+                job.audio = dir / value;
+            else if (key == "state")
+                job.state = dir / value;
+            else if (key == "frames")
+                valid = has_frames = parseNumber(value, job.frames);
+            else if (key == "cycles")
+                valid = has_cycles = parseNumber(value, job.cycles);
+            else
+                valid = false;
+
+            if (!valid)
+            {
+                LOG_ERROR("{}:{}: invalid field \"{}\"\n", path.string(),
+                          line_num, field);
+                return false;
+            }
+        }
+
+        if (job.rom.empty())
+        {
+            LOG_ERROR("{}:{}: missing rom\n", path.string(), line_num);
+            return false;
+        }
+
+        if (!has_frames)
+            job.frames = has_cycles ? std::numeric_limits<u32>::max()
+                                    : DEFAULT_FRAME_COUNT;
+        if (!has_cycles)
+            job.cycles = std::numeric_limits<u64>::max();
+
+        job.name = fmt::format("{}:{} ({})", path.filename().string(),
+                               line_num, job.rom.filename().string());
+        jobs.push_back(std::move(job));
+    }
+
+    return true;
+}
+
+static bool parseMovie(const fs::path& path, std::vector<MovieInput>& movie)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string frame, buttons;
+        if (!(fields >> frame))
+            continue;
+
+        MovieInput input;
+        if (!(fields >> buttons) || !parseNumber(frame, input.frame) ||
+            !parseNumber(buttons, input.buttons))
+            return false;
+        movie.push_back(input);
+    }
+
+    std::stable_sort(movie.begin(), movie.end(),
+                     [](auto& a, auto& b) { return a.frame < b.frame; });
+    return true;
+}
+
+// FNV-1a
+static u64 hashFrame(const IndexedFrame& frame)
+{
+    auto bytes = reinterpret_cast<const u8*>(&frame);
+    u64 hash = 0xCBF29CE484222325;
+    for (size_t i = 0; i < sizeof(IndexedFrame); i++)
+        hash = (hash ^ bytes[i]) * 0x100000001B3;
+    return hash;
+}
+
+static JobResult runJob(const Job& job, std::shared_ptr<const MappedFile> rom,
+                        const std::vector<u8>* bootrom)
+{
+    JobResult result = {};
+
+    std::vector<MovieInput> movie;
+    if (!job.movie.empty() && !parseMovie(job.movie, movie))
+    {
+        result.error = fmt::format("invalid movie {}", job.movie.string());
+        return result;
+    }
+
+    auto cart = Cart::open(std::move(rom), false);
+    if (!cart)
+    {
+        result.error = fmt::format("invalid rom {}", job.rom.string());
+        return result;
+    }
+
+    Gameboy gb;
+    if (bootrom)
+        gb.setBootrom(*bootrom);
+    gb.setCartridge(std::move(cart.value()));
+    gb.powerOn();
+
+    std::unique_ptr<CaptureAudioSink> capture;
+    if (!job.audio.empty())
+    {
+        auto format = job.audio.extension() == ".raw" ? CaptureFormat_Raw
+                                                      : CaptureFormat_Wav;
+        auto sink = CaptureAudioSink::open(job.audio, format);
+        if (!sink)
+        {
+            result.error = fmt::format("could not open {}",
+                                       job.audio.string());
+            return result;
+        }
+        capture = std::move(sink.value());
+        gb.apu()->setSink(capture.get());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    size_t start_clocks = gb.cpu()->clocks();
+    size_t next_input = 0;
+    for (; result.frames < job.frames; result.frames++)
+    {
+        while (next_input < movie.size() &&
+               movie[next_input].frame <= result.frames)
+            gb.joypad()->setButtons(movie[next_input++].buttons);
+
+        u64 clocks = gb.cpu()->clocks() - start_clocks;
+        if (clocks >= job.cycles)
+            break;
+
+        if (job.cycles - clocks < FRAME_CYCLES)
+            gb.runCycles(job.cycles - clocks);
+        else
+            gb.runFrame();
+    }
+    result.clocks = gb.cpu()->clocks() - start_clocks;
+
+    result.seconds = std::chrono::duration<f64>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    result.frame_hash = hashFrame(gb.ppu()->frame());
+
+    gb.apu()->setSink(nullptr);
+    if (capture && !capture->close())
+        result.error = fmt::format("could not write {}", job.audio.string());
+
+    if (!job.state.empty())
+    {
+        std::vector<u8> state(gb.stateSize());
+        if (!gb.saveState(state) ||
+            !File::writeAllBytes(job.state, state.data(), state.size()))
+            result.error = fmt::format("could not write {}",
+                                       job.state.string());
+    }
+
+    return result;
+}
+
+s32 main(s32 argc, char** argv)
+{
+    ArgParser args;
+
+    args.registerArg({ "--manifest", "The list of jobs to run",
+                       ArgParser::ArgType_StringNext, std::nullopt });
+    args.registerArg({ "--jobs",
+                       "Number of threads (one per core by default)",
+                       ArgParser::ArgType_U32, std::nullopt });
+
+    auto manifest = args.parse(argc, argv) ? args.getArg("--manifest")
+                                           : std::nullopt;
+    if (!manifest || !manifest->value)
+    {
+        args.showUsage();
+        return 1;
+    }
+
+    std::vector<Job> jobs;
+    if (!parseManifest(manifest->value->value, jobs))
+        return 1;
+
+    u32 thread_count = 0;
+    if (auto threads = args.getArg("--jobs"); threads && threads->value)
+        thread_count = threads->value->value_u32;
+
+    std::vector<JobResult> results(jobs.size());
+
+    // loaded up front so that the jobs share them
+    std::map<fs::path, std::shared_ptr<const MappedFile>> roms;
+    std::map<fs::path, std::vector<u8>> bootroms;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        auto& job = jobs[i];
+        if (!roms.contains(job.rom))
+        {
+            auto rom = File::mapReadOnly(job.rom);
+            // truncated ROMs fail their jobs instead of the whole batch
+            if (rom && Cart::validate(rom.value()->bytes()))
+                roms[job.rom] = std::move(rom.value());
+            else
+                roms[job.rom] = nullptr;
+        }
+        if (!job.bootrom.empty() && !bootroms.contains(job.bootrom))
+        {
+            auto bootrom = File::readAllBytes(job.bootrom);
+            bootroms[job.bootrom] = bootrom.value_or(std::vector<u8>());
+        }
+
+        if (!roms[job.rom])
+            results[i].error = fmt::format("invalid rom {}", job.rom.string());
+        else if (!job.bootrom.empty() &&
+                 bootroms[job.bootrom].size() != BOOTROM_SIZE)
+            results[i].error = fmt::format("invalid bootrom {}",
+                                           job.bootrom.string());
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    size_t used_threads;
+    {
+        ThreadPool pool(thread_count);
+        used_threads = pool.threadCount();
+
+        for (size_t i = 0; i < jobs.size(); i++)
+        {
+            if (!results[i].error.empty())
+                continue;
+
+            auto& job = jobs[i];
+            auto rom = roms[job.rom];
+            auto bootrom = job.bootrom.empty() ? nullptr
+                                               : &bootroms[job.bootrom];
+            pool.submit([&, i, rom, bootrom]
+                        { results[i] = runJob(job, rom, bootrom); });
+        }
+        pool.wait();
+    }
+    auto elapsed = std::chrono::duration<f64>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+    // in manifest order, so that reports can be diffed
+    size_t failed = 0;
+    f64 emulated = 0.0;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        auto& result = results[i];
+        if (!result.error.empty())
+        {
+            fmt::print("{}: FAILED, {}\n", jobs[i].name, result.error);
+            failed++;
+            continue;
+        }
+
+        f64 seconds = static_cast<f64>(result.clocks) / Timer::SYSTEM_FREQUENCY;
+        emulated += seconds;
+        fmt::print("{}: {} frames in {:.3f}s ({:.1f} FPS, {:.2f}x real-time), "
+                   "frame {:016x}\n",
+                   jobs[i].name, result.frames, result.seconds,
+                   result.frames / result.seconds, seconds / result.seconds,
+                   result.frame_hash);
+    }
+
+    fmt::print("{} jobs ({} failed) on {} threads in {:.3f}s, "
+               "{:.2f}x real-time overall\n",
+               jobs.size(), failed, used_threads, elapsed, emulated / elapsed);
+
+    return failed == 0 ? 0 : 1;
+}
@@ -2,8 +2,17 @@
 #include <fstream>
 #include <iterator>
 #include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "macro.hpp"
 
+MappedFile::~MappedFile()
+{
+    munmap(const_cast<u8*>(m_data), m_size);
+}
+
 bool File::exists(const fs::path& path)
 {
     return fs::exists(path) && !fs::is_directory(path);
@@ -34,6 +43,26 @@ File::Result<std::vector<u8>> File::readAllBytes(const fs::path& path)
     return ret;
 }
 
+File::Result<std::shared_ptr<const MappedFile>> File::mapReadOnly(
+    const fs::path& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    ERROR_IF(fd < 0, FileSystemError_FileOpenFailed);
+
+    struct stat st;
+    void* data = MAP_FAILED;
+    // empty files can't be mapped
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid
+    close(fd);
+
+    ERROR_IF(data == MAP_FAILED, FileSystemError_MapFailed);
+
+    return std::shared_ptr<const MappedFile>(
+        new MappedFile(static_cast<const u8*>(data), st.st_size));
+}
+
 File::Result<void> File::writeAllBytes(const fs::path& path, const void* data,
                                        size_t size)
 {
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <span>
 #include <vector>
 #include "tl/expected.hpp"
 #include "types.hpp"
@@ -10,6 +12,29 @@ namespace fs = std::filesystem;
 enum FileSystemError
 {
     FileSystemError_FileOpenFailed,
+    FileSystemError_MapFailed,
+    FileSystemError_WriteFailed,
+};
+
+// Read-only mapping of a whole file. The pages are loaded on first access
+// and shared with every other mapping of the same file.
+class MappedFile
+{
+public:
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const u8> bytes() const { return { m_data, m_size }; }
+
+private:
+    friend class File;
+    MappedFile(const u8* data, size_t size) : m_data(data), m_size(size) {}
+
+private:
+    const u8* m_data;
+    size_t m_size;
 };
 
 class File
@@ -19,6 +44,9 @@ public:
     using Result = tl::expected<T, FileSystemError>;
 
     static Result<std::vector<u8>> readAllBytes(const fs::path& path);
+    // the file must not be modified while mapped
+    static Result<std::shared_ptr<const MappedFile>> mapReadOnly(
+        const fs::path& path);
     static Result<void> writeAllBytes(const fs::path& path, const void* data,
                                       size_t size);
 
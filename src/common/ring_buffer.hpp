@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <vector>
+#include "types.hpp"
+
+// Lock-free single producer / single consumer ring buffer with bulk reads and
+// writes, meant for streams such as audio samples.
+template<typename T>
+class RingBuffer
+{
+public:
+    // capacity is rounded up to a power of two
+    RingBuffer(size_t capacity) : m_items(std::bit_ceil(capacity)) {}
+
+    size_t capacity() const { return m_items.size(); }
+    size_t size() const
+    {
+        return m_tail.load(std::memory_order_acquire) -
+               m_head.load(std::memory_order_acquire);
+    }
+
+    // producer, returns the number of items written
+    size_t write(const T* items, size_t count)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+        count = std::min(count, capacity() - (tail - head));
+
+        // may wrap around
+        size_t start = tail & (capacity() - 1);
+        size_t first = std::min(count, capacity() - start);
+        std::copy_n(items, first, m_items.begin() + start);
+        std::copy_n(items + first, count - first, m_items.begin());
+
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // consumer, returns the number of items read
+    size_t read(T* items, size_t count)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        count = std::min(count, tail - head);
+
+        size_t start = head & (capacity() - 1);
+        size_t first = std::min(count, capacity() - start);
+        std::copy_n(m_items.begin() + start, first, items);
+        std::copy_n(m_items.begin(), count - first, items + first);
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    std::vector<T> m_items;
+    alignas(64) std::atomic<size_t> m_head = 0;
+    alignas(64) std::atomic<size_t> m_tail = 0;
+};
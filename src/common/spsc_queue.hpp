@@ -0,0 +1,50 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include "types.hpp"
+
+// Bounded lock-free single producer / single consumer queue.
+template<typename T, size_t N>
+class SpscQueue
+{
+    static_assert(N != 0 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+    // producer, returns false if the queue is full
+    bool push(const T& value)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == N)
+            return false;
+
+        m_items[tail & (N - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer
+    std::optional<T> pop()
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return std::nullopt;
+
+        T value = m_items[head & (N - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) ==
+               m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, N> m_items{};
+    // on separate cache lines so that both sides don't keep stealing them
+    alignas(64) std::atomic<size_t> m_head = 0;
+    alignas(64) std::atomic<size_t> m_tail = 0;
+};
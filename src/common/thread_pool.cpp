@@ -0,0 +1,115 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t thread_count) :
+    m_next_worker(0),
+    m_queued(0),
+    m_pending(0),
+    m_stop(false)
+{
+    if (thread_count == 0)
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < thread_count; i++)
+        m_workers.push_back(std::make_unique<Worker>());
+    // only started once every queue exists
+    for (size_t i = 0; i < thread_count; i++)
+        m_workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    wait();
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_work_cv.notify_all();
+
+    for (auto& worker : m_workers)
+        worker->thread.join();
+}
+
+void ThreadPool::submit(Task task)
+{
+    size_t index = m_next_worker.fetch_add(1, std::memory_order_relaxed);
+    auto& worker = *m_workers[index % m_workers.size()];
+
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+        m_queued.fetch_add(1, std::memory_order_release);
+    }
+
+    // a worker that just found nothing is either already asleep or sees the
+    // new task before going to sleep
+    {
+        std::lock_guard lock(m_mutex);
+    }
+    m_work_cv.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock(m_mutex);
+    m_done_cv.wait(lock, [this] { return m_pending.load() == 0; });
+}
+
+std::optional<ThreadPool::Task> ThreadPool::take(size_t index)
+{
+    // own queue first, newest task
+    {
+        auto& worker = *m_workers[index];
+        std::lock_guard lock(worker.mutex);
+        if (!worker.tasks.empty())
+        {
+            Task task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    // then steal the oldest task of the next busy worker
+    for (size_t i = 1; i < m_workers.size(); i++)
+    {
+        auto& victim = *m_workers[(index + i) % m_workers.size()];
+        std::lock_guard lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            Task task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_queued.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    while (true)
+    {
+        if (auto task = take(index))
+        {
+            (*task)();
+
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard lock(m_mutex);
+                m_done_cv.notify_all();
+            }
+            continue;
+        }
+
+        // nothing left anywhere, sleep until a task is queued. A task queued
+        // after the scan keeps m_queued above 0, so this never sleeps on it.
+        std::unique_lock lock(m_mutex);
+        m_work_cv.wait(lock, [this] { return m_queued.load() != 0 || m_stop; });
+        if (m_queued.load() == 0)
+            return;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "types.hpp"
+
+// Fixed set of workers running independent tasks.
+// Tasks are handed out round-robin to per-worker queues. A worker takes the
+// newest task of its own queue and, once it runs dry, steals the oldest one
+// of another queue, so uneven tasks still keep every thread busy without a
+// single contended queue. The pool-wide lock is only taken to sleep when
+// there is nothing left to take and to wake sleeping threads up.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    // 0 uses one thread per hardware thread
+    ThreadPool(size_t thread_count = 0);
+    // completes the pending tasks first
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(Task task);
+    // blocks until every submitted task has returned
+    void wait();
+
+    size_t threadCount() const { return m_workers.size(); }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void workerLoop(size_t index);
+    std::optional<Task> take(size_t index);
+
+private:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<size_t> m_next_worker;
+    // only changed with the lock of the queue holding the task, so it is
+    // never 0 while a task can be taken
+    std::atomic<size_t> m_queued;
+    std::atomic<size_t> m_pending; // submitted and not completed yet
+
+    // sleeping and waking up only
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv; // a task was queued or stopping
+    std::condition_variable m_done_cv; // every task completed
+    bool m_stop;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include "types.hpp"
+
+// Lock-free single producer / single consumer triple buffer.
+// The producer always has a buffer to write to and the consumer always reads
+// the most recently published one; neither side ever waits on the other.
+template<typename T>
+class TripleBuffer
+{
+public:
+    // producer
+    T& writeBuffer() { return m_buffers[m_write]; }
+    void publish()
+    {
+        u8 prev = m_middle.exchange(m_write | DIRTY, std::memory_order_acq_rel);
+        m_write = prev & INDEX_MASK;
+    }
+
+    // consumer, returns true if a new buffer was published since the last call
+    bool update()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & DIRTY))
+            return false;
+
+        u8 prev = m_middle.exchange(m_read, std::memory_order_acq_rel);
+        m_read = prev & INDEX_MASK;
+        return true;
+    }
+    const T& readBuffer() const { return m_buffers[m_read]; }
+
+private:
+    static constexpr u8 INDEX_MASK = 0x3;
+    static constexpr u8 DIRTY = 0x4;
+
+    std::array<T, 3> m_buffers{};
+    u8 m_write = 0;
+    std::atomic<u8> m_middle = 1;
+    u8 m_read = 2;
+};
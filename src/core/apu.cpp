@@ -1,299 +1,600 @@
 #include "apu.hpp"
+#include <algorithm>
 #include "common/logging.hpp"
+#include "backend.hpp"
 #include "io.hpp"
 #include "memory.hpp"
+#include "save_state.hpp"
+#include "scheduler.hpp"
 #include "timer.hpp"
 
 namespace gbemu::core
 {
 
-static constexpr f64 WAVE_REG_TO_FREQ(u16 reg)
+// T-states between two sample blocks, ~1ms
+static constexpr size_t SYNC_PERIOD = 4096;
+// the frame sequencer is clocked by the falling edge of DIV bit 4
+static constexpr size_t FRAME_SEQ_PERIOD = 8192;
+// max samples per channel between two sync points
+static constexpr size_t BLIP_CAPACITY = AUDIO_BUFFER_SIZE / 2;
+// max output rate adjustment, small enough not to be heard as a pitch change
+static constexpr f64 MAX_RATE_DELTA = 0.005;
+// blip samples that may be pending between two sync points, with margin
+static constexpr size_t BLIP_STATE_SAMPLES =
+    2 * SYNC_PERIOD * AUDIO_SAMPLE_RATE / Timer::SYSTEM_FREQUENCY +
+    BlipBuffer::TAPS;
+// amplitude of one DAC step, leaves some headroom when mixing the channels
+static constexpr s32 VOLUME_UNIT = 0x7FFF / (4 * 0xF);
+
+static constexpr u8 DUTY_PATTERNS[4] = {
+    0b00000001, // 12.5%
+    0b10000001, // 25%
+    0b10000111, // 50%
+    0b01111110, // 75%
+};
+static constexpr u8 WAVE_SHIFT[4] = { 4, 0, 1, 2 };
+static constexpr u8 NOISE_DIVISORS[8] = { 8, 16, 32, 48, 64, 80, 96, 112 };
+
+// unused and write only bits read as 1, indexed from NR10
+static constexpr u8 READ_MASKS[] = {
+    0x80, 0x3F, 0x00, 0xFF, 0xBF, // NR10 - NR14
+    0xFF, 0x3F, 0x00, 0xFF, 0xBF, // NR20 - NR24
+    0x7F, 0xFF, 0x9F, 0xFF, 0xBF, // NR30 - NR34
+    0xFF, 0xFF, 0x00, 0x00, 0xBF, // NR40 - NR44
+    0x00, 0x00, 0x70,             // NR50 - NR52
+};
+
+Apu::Apu(Scheduler* scheduler) :
+    m_channels{},
+    m_sweep_freq(0),
+    m_sweep_timer(0),
+    m_sweep_enabled(false),
+    m_lfsr(0x7FFF),
+    m_clocks(0),
+    m_div_start(0),
+    m_next_frame_seq(FRAME_SEQ_PERIOD),
+    m_frame_seq_step(0),
+    m_blips{
+        { Timer::SYSTEM_FREQUENCY, AUDIO_SAMPLE_RATE, BLIP_CAPACITY },
+        { Timer::SYSTEM_FREQUENCY, AUDIO_SAMPLE_RATE, BLIP_CAPACITY },
+        { Timer::SYSTEM_FREQUENCY, AUDIO_SAMPLE_RATE, BLIP_CAPACITY },
+        { Timer::SYSTEM_FREQUENCY, AUDIO_SAMPLE_RATE, BLIP_CAPACITY },
+    },
+    m_frame_start(0),
+    m_scheduler(scheduler),
+    m_sink(nullptr)
 {
-    return 65536.0 / (2048 - reg);
+    for (u16 addr = NR10_ADDR; addr <= NR51_ADDR; addr++)
+    {
+        if (u8* reg = registerPtr(addr))
+            *reg = 0;
+    }
+    *reinterpret_cast<u8*>(&m_nr52) = 0;
+
+    m_scheduler->setHandler(EventType_Apu,
+                            Scheduler::handler<&Apu::onAudioEvent>(this));
+    m_scheduler->schedule(EventType_Apu, SYNC_PERIOD);
 }
-static constexpr u16 FREQ_TO_WAVE_REG(f64 f)
+
+Apu::~Apu()
 {
-    return -65536.0 / f + 2048;
 }
 
-static constexpr f64 WAVE_REG_TO_DURATION(u8 reg)
+void Apu::mapMemory(Memory* mem)
 {
-    return (256 - reg) * (1.0 / 256.0);
+    u16 size = NR52_ADDR - NR10_ADDR + 1;
+    mem->mapRW(MmioRead(NR10_ADDR, size,
+                        MmioRead::handler<&Apu::readRegister>(this)),
+               MmioWrite(NR10_ADDR, size,
+                         MmioWrite::handler<&Apu::writeRegister>(this)));
+
+    mem->mapRW(MmioRead(W0_ADDR, sizeof(m_wave),
+                        MmioRead::handler<&Apu::readWave>(this)),
+               MmioWrite(W0_ADDR, sizeof(m_wave),
+                         MmioWrite::handler<&Apu::writeWave>(this)));
 }
-static constexpr u8 DURATION_TO_WAVE_REG(f64 t)
+
+void Apu::saveState(StateWriter& state)
 {
-    return -t * 256.0 + 256.0;
+    for (u16 addr = NR10_ADDR; addr <= NR51_ADDR; addr++)
+    {
+        if (u8* reg = registerPtr(addr))
+            state.write(*reg);
+    }
+    state.write(m_nr52);
+    state.write(m_wave);
+
+    state.write(m_channels);
+    state.write(m_sweep_freq);
+    state.write(m_sweep_timer);
+    state.write(m_sweep_enabled);
+    state.write(m_lfsr);
+
+    state.write(m_clocks);
+    state.write(m_div_start);
+    state.write(m_next_frame_seq);
+    state.write(m_frame_seq_step);
+
+    for (auto& blip : m_blips)
+        blip.saveState(state, BLIP_STATE_SAMPLES);
+    state.write(m_frame_start);
 }
 
-static constexpr f64 PULSEA_REG_TO_FREQ(u16 reg)
+void Apu::loadState(StateReader& state)
 {
-    return 131072.0 / (2048 - reg);
+    for (u16 addr = NR10_ADDR; addr <= NR51_ADDR; addr++)
+    {
+        if (u8* reg = registerPtr(addr))
+            state.read(*reg);
+    }
+    state.read(m_nr52);
+    state.read(m_wave);
+
+    state.read(m_channels);
+    state.read(m_sweep_freq);
+    state.read(m_sweep_timer);
+    state.read(m_sweep_enabled);
+    state.read(m_lfsr);
+
+    state.read(m_clocks);
+    state.read(m_div_start);
+    state.read(m_next_frame_seq);
+    state.read(m_frame_seq_step);
+
+    for (auto& blip : m_blips)
+        blip.loadState(state, BLIP_STATE_SAMPLES);
+    state.read(m_frame_start);
 }
-static constexpr u16 FREQ_TO_PULSEA_REG(f64 f)
+
+u8* Apu::registerPtr(u16 addr)
 {
-    return -131072.0 / f + 2048;
+    switch (addr)
+    {
+        case NR10_ADDR: return &m_nr10.raw;
+        case NR11_ADDR: return &m_nr11.raw;
+        case NR12_ADDR: return &m_nr12.raw;
+        case NR13_ADDR: return &m_nr13.raw;
+        case NR14_ADDR: return &m_nr14.raw;
+        case NR21_ADDR: return &m_nr21.raw;
+        case NR22_ADDR: return &m_nr22.raw;
+        case NR23_ADDR: return &m_nr23.raw;
+        case NR24_ADDR: return &m_nr24.raw;
+        case NR30_ADDR: return &m_nr30.raw;
+        case NR31_ADDR: return &m_nr31.raw;
+        case NR32_ADDR: return &m_nr32.raw;
+        case NR33_ADDR: return &m_nr33.raw;
+        case NR34_ADDR: return &m_nr34.raw;
+        case NR41_ADDR: return &m_nr41.raw;
+        case NR42_ADDR: return &m_nr42.raw;
+        case NR43_ADDR: return &m_nr43.raw;
+        case NR44_ADDR: return &m_nr44.raw;
+        case NR50_ADDR: return reinterpret_cast<u8*>(&m_nr50);
+        case NR51_ADDR: return reinterpret_cast<u8*>(&m_nr51);
+        default: return nullptr;
+    }
 }
 
-static constexpr f64 PULSEA_REG_TO_DURATION(u8 reg)
+Result<u8> Apu::readRegister(u16 off)
 {
-    return (64 - reg) * (1.0 / 256.0);
+    catchUp(m_scheduler->clocks());
+
+    u16 addr = NR10_ADDR + off;
+    if (addr == NR52_ADDR)
+    {
+        m_nr52.sound_1_on = m_channels[ChannelId_Pulse1].enabled;
+        m_nr52.sound_2_on = m_channels[ChannelId_Pulse2].enabled;
+        m_nr52.sound_3_on = m_channels[ChannelId_Wave].enabled;
+        m_nr52.sound_4_on = m_channels[ChannelId_Noise].enabled;
+        return *reinterpret_cast<u8*>(&m_nr52) | READ_MASKS[off];
+    }
+
+    u8* reg = registerPtr(addr);
+    return (reg ? *reg : 0) | READ_MASKS[off];
 }
-static constexpr u8 DURATION_TO_PULSEA_REG(f64 t)
+
+Result<void> Apu::writeRegister(u16 off, u8 data)
 {
-    return -t * 256.0 + 64.0;
-}
+    catchUp(m_scheduler->clocks());
+
+    u16 addr = NR10_ADDR + off;
+    if (addr == NR52_ADDR)
+    {
+        bool was_on = m_nr52.all_sound_on;
+        m_nr52.all_sound_on = data >> 7;
+
+        if (was_on && !m_nr52.all_sound_on)
+        {
+            for (u16 addr = NR10_ADDR; addr <= NR51_ADDR; addr++)
+            {
+                if (u8* reg = registerPtr(addr))
+                    *reg = 0;
+            }
+            for (auto& ch : m_channels)
+                ch.enabled = false;
+        }
+        else if (!was_on && m_nr52.all_sound_on)
+            m_frame_seq_step = 0;
+
+        updateOutputs(m_clocks);
+        return {};
+    }
+
+    // only NR52 is writable while the APU is off
+    u8* reg = registerPtr(addr);
+    if (!reg || !m_nr52.all_sound_on)
+        return {};
+
+    *reg = data;
 
-using Func1 = std::function<f64(f64)>;
+    switch (addr)
+    {
+        case NR11_ADDR:
+        case NR21_ADDR:
+        case NR41_ADDR:
+            m_channels[(addr - NR11_ADDR) / 5].length = 64 - (data & 0x3F);
+            break;
+        case NR31_ADDR: m_channels[ChannelId_Wave].length = 256 - data; break;
+
+        // turning a DAC off disables its channel
+        case NR12_ADDR:
+        case NR22_ADDR:
+        case NR42_ADDR:
+            if ((data & 0xF8) == 0)
+                m_channels[(addr - NR12_ADDR) / 5].enabled = false;
+            break;
+        case NR30_ADDR:
+            if (!m_nr30.dac_enable)
+                m_channels[ChannelId_Wave].enabled = false;
+            break;
+
+        case NR14_ADDR:
+        case NR24_ADDR:
+        case NR34_ADDR:
+        case NR44_ADDR:
+            if (data & 0x80)
+                trigger(static_cast<ChannelId>((addr - NR14_ADDR) / 5));
+            break;
+
+        default: break;
+    }
+
+    updateOutputs(m_clocks);
+    return {};
+}
 
-static Func1 constant(f64 c)
+Result<u8> Apu::readWave(u16 off)
 {
-    return [c](f64 x) -> f64 { return c; };
+    catchUp(m_scheduler->clocks());
+    return m_wave[off];
 }
 
-static Func1 linearMap(f64 start, f64 end)
+Result<void> Apu::writeWave(u16 off, u8 data)
 {
-    return [start, end](f64 x) -> f64 { return start + (end - start) * x; };
+    catchUp(m_scheduler->clocks());
+    m_wave[off] = data;
+    return {};
 }
 
-static Func1 stepMap(f64 start, f64 end, size_t step_count)
+bool Apu::dacEnabled(ChannelId id)
 {
-    return [start, end, step_count](f64 x) -> f64
+    switch (id)
     {
-        x = floor(x * step_count) / step_count;
-        return start + (end - start) * x;
-    };
+        case ChannelId_Pulse1: return m_nr12.raw & 0xF8;
+        case ChannelId_Pulse2: return m_nr22.raw & 0xF8;
+        case ChannelId_Wave: return m_nr30.dac_enable;
+        case ChannelId_Noise: return m_nr42.raw & 0xF8;
+        default: UNREACHABLE("Invalid channel {}", static_cast<u8>(id));
+    }
 }
 
-static void generateSamples(f64* prev_x, s16* samples, size_t sample_count,
-                            Func1 freq, Func1 volume, Func1 generator)
+size_t Apu::timerPeriod(ChannelId id)
 {
-
-    for (size_t i = 0; i < sample_count; i++)
+    switch (id)
     {
-        // f64 t = (f64)i / sample_count;
-        f64 t = 0; // TODO: counter / counter_start;
-        f64 f = freq(t);
-
-        f64 x = fmod(*prev_x + (f / AUDIO_SAMPLE_RATE), 1.0);
-        *prev_x = x;
+        case ChannelId_Pulse1: return (2048 - m_nr13_nr14.freq) * 4;
+        case ChannelId_Pulse2: return (2048 - m_nr23_nr24.freq) * 4;
+        case ChannelId_Wave: return (2048 - m_nr33_nr34.freq) * 2;
+        case ChannelId_Noise:
+            return NOISE_DIVISORS[m_nr43.divisor_code] << m_nr43.clock_shift;
+        default: UNREACHABLE("Invalid channel {}", static_cast<u8>(id));
+    }
+}
 
-        f64 y = generator(x);
+void Apu::trigger(ChannelId id)
+{
+    Channel& ch = m_channels[id];
 
-        s16 sample = y * volume(t) * 0x7FFF;
+    ch.enabled = dacEnabled(id);
+    if (ch.length == 0)
+        ch.length = id == ChannelId_Wave ? 256 : 64;
+    ch.next_edge = m_clocks + timerPeriod(id);
 
-        *samples++ = sample; // left
-        *samples++ = sample; // right
+    switch (id)
+    {
+        case ChannelId_Pulse1:
+            ch.volume = m_nr12.initial_envelope_volume;
+            ch.envelope_timer = m_nr12.number_of_envelope_sweep;
+
+            m_sweep_freq = m_nr13_nr14.freq;
+            m_sweep_timer = m_nr10.sweep_time ? m_nr10.sweep_time : 8;
+            m_sweep_enabled = m_nr10.sweep_time || m_nr10.number_of_seep;
+            // overflow check
+            if (m_nr10.number_of_seep)
+                sweepFrequency();
+            break;
+        case ChannelId_Pulse2:
+            ch.volume = m_nr22.initial_envelope_volume;
+            ch.envelope_timer = m_nr22.number_of_envelope_sweep;
+            break;
+        case ChannelId_Wave: ch.position = 0; break;
+        case ChannelId_Noise:
+            ch.volume = m_nr42.initial_envelope_volume;
+            ch.envelope_timer = m_nr42.number_of_envelope_sweep;
+            m_lfsr = 0x7FFF;
+            break;
+        default: UNREACHABLE("Invalid channel {}", static_cast<u8>(id));
     }
 }
 
-void Apu::decodeChannelWave(s16* samples, size_t sample_count)
+void Apu::setAmplitude(ChannelId id, s32 value, size_t clocks)
 {
-    // TODO: use duration
-    f64 duration = WAVE_REG_TO_DURATION(m_nr31.sound_length);
-    f64 freq = WAVE_REG_TO_FREQ(m_nr33_nr34.freq);
-    u8* wave = m_wave;
+    Channel& ch = m_channels[id];
+    if (value == ch.amplitude)
+        return;
 
-    f64 volume_lut[] = { 0, 1.0, 0.5, 0.25 };
-    f64 volume = (volume_lut[m_nr32.volume]);
-    volume *= 0.3;
+    m_blips[id].addDelta(clocks - m_frame_start,
+                         (value - ch.amplitude) * VOLUME_UNIT);
+    ch.amplitude = value;
+}
+
+void Apu::updateOutputs(size_t clocks)
+{
+    for (size_t i = 0; i < ChannelId_Count; i++)
+    {
+        Channel& ch = m_channels[i];
+        s32 value = 0;
+        if (ch.enabled && i == ChannelId_Wave)
+            value = ch.level >> WAVE_SHIFT[m_nr32.volume];
+        else if (ch.enabled)
+            value = ch.level * ch.volume;
+
+        setAmplitude(static_cast<ChannelId>(i), value, clocks);
+    }
+}
 
-    // todo: replace wave
-    auto func = [wave](f64 t) -> f64
+void Apu::catchUp(size_t clocks)
+{
+    while (m_next_frame_seq <= clocks)
     {
-        size_t sample_idx = t * 31;
-        size_t shift = (sample_idx % 2 == 0) ? 4 : 0;
-        u8 sample = (wave[sample_idx / 2] >> shift) & 0xF;
-        return sample * 2.0 / 0xF - 1.0;
-    };
-
-    generateSamples(&m_ch3_prev_x, samples, sample_count, constant(freq),
-                    constant(volume), func);
+        runChannels(m_next_frame_seq);
+        stepFrameSequencer();
+        m_next_frame_seq += FRAME_SEQ_PERIOD;
+    }
+    runChannels(clocks);
 }
 
-void Apu::decodeChannelPulseA(s16* samples, size_t sample_count)
+void Apu::runChannels(size_t clocks)
 {
-    f64 threshold_lut[] = { 0.125, 0.25, 0.5, 0.75 };
-    f64 threshold = threshold_lut[m_nr11.wave_pattern_duty];
-    f64 duration = PULSEA_REG_TO_DURATION(m_nr11.sound_length);
-    f64 freq = PULSEA_REG_TO_FREQ(m_nr13_nr14.freq);
+    if (clocks <= m_clocks)
+        return;
+
+    runPulse(ChannelId_Pulse1, clocks);
+    runPulse(ChannelId_Pulse2, clocks);
+    runWave(clocks);
+    runNoise(clocks);
+    m_clocks = clocks;
+}
 
-    f64 volume_end = m_nr12.envelope_direction ? 1.0f : 0.0f;
-    f64 volume_start = (f64)m_nr12.initial_envelope_volume / 0xF;
+// disabled channels jump past `clocks` instead of stepping through every edge
+static void skipEdges(size_t& next_edge, size_t period, size_t clocks)
+{
+    if (next_edge <= clocks)
+        next_edge += ((clocks - next_edge) / period + 1) * period;
+}
 
-    u8 sweep_count = m_nr12.number_of_envelope_sweep;
-    bool stop = m_nr14.counter_selection;
-    bool restart = m_nr14.initial;
+void Apu::runPulse(ChannelId id, size_t clocks)
+{
+    Channel& ch = m_channels[id];
+    size_t period = timerPeriod(id);
+    u8 duty = id == ChannelId_Pulse1 ? m_nr11.wave_pattern_duty
+                                     : m_nr21.wave_pattern_duty;
 
-    static size_t i = 0;
-    if (i++ % 1000 == 0)
+    if (!ch.enabled)
     {
-        // LOG("PULSE A : envelop={}; threshold={}%; freq={}Hz;
-        // volume={}%-{}%",
-        //     sweep_count, threshold, floor(freq), floor(volume_start*100),
-        //     floor(volume_end*100));
-        // LOG("{:>20}", "");
+        skipEdges(ch.next_edge, period, clocks);
+        return;
     }
 
-    auto func = [threshold](f64 t) -> f64
+    for (; ch.next_edge <= clocks; ch.next_edge += period)
     {
-        f64 y = t < threshold ? 1.0 : -1.0;
-        return y;
-    };
+        ch.position = (ch.position + 1) & 7;
+        ch.level = (DUTY_PATTERNS[duty] >> (7 - ch.position)) & 1;
+        setAmplitude(id, ch.level * ch.volume, ch.next_edge);
+    }
+}
 
-    f64 volume = 0.3;
-    volume_start *= volume;
-    volume_end *= volume;
+void Apu::runWave(size_t clocks)
+{
+    Channel& ch = m_channels[ChannelId_Wave];
+    size_t period = timerPeriod(ChannelId_Wave);
+    u8 shift = WAVE_SHIFT[m_nr32.volume];
 
-    Func1 envelop = sweep_count == 0
-                        ? constant(volume_start)
-                        : stepMap(volume_start, volume_end, 64 / sweep_count);
+    if (!ch.enabled)
+    {
+        skipEdges(ch.next_edge, period, clocks);
+        return;
+    }
 
-    // todo: freq sweep + use duration
-    generateSamples(&m_ch1_prev_x, samples, sample_count, constant(freq),
-                    envelop, func);
+    for (; ch.next_edge <= clocks; ch.next_edge += period)
+    {
+        ch.position = (ch.position + 1) & 31;
+        u8 byte = m_wave[ch.position / 2];
+        ch.level = (ch.position & 1) ? (byte & 0xF) : (byte >> 4);
+        setAmplitude(ChannelId_Wave, ch.level >> shift, ch.next_edge);
+    }
 }
 
-void Apu::decodeChannelPulseB(s16* samples, size_t sample_count)
+void Apu::runNoise(size_t clocks)
 {
-    f64 threshold_lut[] = { 0.125, 0.25, 0.5, 0.75 };
-    f64 threshold = threshold_lut[m_nr21.wave_pattern_duty];
-    f64 duration = PULSEA_REG_TO_DURATION(m_nr21.sound_length);
-    f64 freq = PULSEA_REG_TO_FREQ(m_nr23_nr24.freq);
-
-    f64 volume_end = m_nr22.envelope_direction ? 1.0f : 0.0f;
-    f64 volume_start = (f64)m_nr22.initial_envelope_volume / 0xF;
-
-    u8 sweep_count = m_nr22.number_of_envelope_sweep;
-    bool stop = m_nr24.counter_selection;
-    bool restart = m_nr24.initial;
+    Channel& ch = m_channels[ChannelId_Noise];
+    size_t period = timerPeriod(ChannelId_Noise);
 
-    static size_t i = 0;
-    if (i++ % 1000 == 0)
+    // shifts 14 and 15 stop the LFSR
+    if (!ch.enabled || m_nr43.clock_shift >= 14)
     {
-        // LOG("PULSE B : envelop={}; threshold={}%; freq={}Hz;
-        // volume={}%-{}%\n",
-        //     sweep_count, threshold, floor(freq), floor(volume_start*100),
-        //     floor(volume_end*100));
+        skipEdges(ch.next_edge, period, clocks);
+        return;
     }
 
-    auto func = [threshold](f64 t) -> f64
+    for (; ch.next_edge <= clocks; ch.next_edge += period)
     {
-        f64 y = t < threshold ? 1.0 : -1.0;
-        return y;
-    };
+        u16 bit = (m_lfsr ^ (m_lfsr >> 1)) & 1;
+        m_lfsr = (m_lfsr >> 1) | (bit << 14);
+        if (m_nr43.width_mode)
+            m_lfsr = (m_lfsr & ~(1 << 6)) | (bit << 6);
+        ch.level = ~m_lfsr & 1;
+        setAmplitude(ChannelId_Noise, ch.level * ch.volume, ch.next_edge);
+    }
+}
 
-    f64 volume = 0.3;
-    volume_start *= volume;
-    volume_end *= volume;
+void Apu::stepFrameSequencer()
+{
+    if (!m_nr52.all_sound_on)
+        return;
+
+    if ((m_frame_seq_step & 1) == 0)
+        clockLength();
+    if (m_frame_seq_step == 2 || m_frame_seq_step == 6)
+        clockSweep();
+    if (m_frame_seq_step == 7)
+        clockEnvelope();
+
+    m_frame_seq_step = (m_frame_seq_step + 1) & 7;
+    updateOutputs(m_clocks);
+}
 
-    Func1 envelop = sweep_count == 0
-                        ? constant(volume_start)
-                        : stepMap(volume_start, volume_end, 64 / sweep_count);
+void Apu::clockLength()
+{
+    const ControlReg* controls[ChannelId_Count] = { &m_nr14, &m_nr24, &m_nr34,
+                                                    &m_nr44 };
 
-    // todo: freq sweep + use duration
-    generateSamples(&m_ch2_prev_x, samples, sample_count, constant(freq),
-                    envelop, func);
+    for (size_t i = 0; i < ChannelId_Count; i++)
+    {
+        Channel& ch = m_channels[i];
+        if (!controls[i]->counter_selection || ch.length == 0)
+            continue;
+
+        if (--ch.length == 0)
+            ch.enabled = false;
+    }
 }
 
-Apu::Apu()
+void Apu::clockEnvelope()
 {
-    m_audio_buffer_size = 0;
-
-    m_nr10.raw = 0;
-    m_nr11.raw = 0;
-    m_nr12.raw = 0;
-    m_nr13.raw = 0;
-    m_nr14.raw = 0;
-
-    m_nr21.raw = 0;
-    m_nr22.raw = 0;
-    m_nr23.raw = 0;
-    m_nr24.raw = 0;
-
-    m_nr31.raw = 0;
-    m_nr32.raw = 0;
-    m_nr33.raw = 0;
-    m_nr34.raw = 0;
-
-    m_ch1_prev_x = 0;
-    m_ch2_prev_x = 0;
-    m_ch3_prev_x = 0;
-    m_ch4_prev_x = 0;
-
-    // m_nr41.raw = 0;
-    // m_nr42.raw = 0;
-    // m_nr43.raw = 0;
-    // m_nr44.raw = 0;
-
-    initPlayer();
+    const VolumeEnvelopReg* envelopes[] = { &m_nr12, &m_nr22, nullptr,
+                                            &m_nr42 };
+
+    for (size_t i = 0; i < ChannelId_Count; i++)
+    {
+        Channel& ch = m_channels[i];
+        const VolumeEnvelopReg* env = envelopes[i];
+        if (!env || env->number_of_envelope_sweep == 0)
+            continue;
+
+        if (ch.envelope_timer > 0 && --ch.envelope_timer > 0)
+            continue;
+
+        ch.envelope_timer = env->number_of_envelope_sweep;
+        if (env->envelope_direction && ch.volume < 0xF)
+            ch.volume++;
+        else if (!env->envelope_direction && ch.volume > 0)
+            ch.volume--;
+    }
 }
 
-Apu::~Apu()
+u16 Apu::sweepFrequency()
 {
-    destroyPlayer();
+    u16 delta = m_sweep_freq >> m_nr10.number_of_seep;
+    u16 freq = m_nr10.sweep_decrease ? m_sweep_freq - delta
+                                     : m_sweep_freq + delta;
+    if (freq > 2047)
+        m_channels[ChannelId_Pulse1].enabled = false;
+    return freq;
 }
 
-void Apu::mapMemory(Memory* mem)
+void Apu::clockSweep()
 {
-    mem->mapRW(NR50_ADDR, &m_nr50);
-    mem->mapRW(NR51_ADDR, &m_nr51);
-    mem->mapRW(NR52_ADDR, &m_nr52, 1, 1 << 7);
-
-    mem->mapRW(NR10_ADDR, &m_nr10);
-    mem->mapRW(NR11_ADDR, &m_nr11); // todo: read mask
-    mem->mapRW(NR12_ADDR, &m_nr12);
-    mem->mapRW(NR13_ADDR, &m_nr13);
-    mem->mapRW(NR14_ADDR, &m_nr14);
-
-    mem->mapRW(NR21_ADDR, &m_nr21);
-    mem->mapRW(NR22_ADDR, &m_nr22);
-    mem->mapRW(NR23_ADDR, &m_nr23);
-    mem->mapRW(NR24_ADDR, &m_nr24);
-
-    mem->mapRW(NR31_ADDR, &m_nr31);
-    mem->mapRW(NR32_ADDR, &m_nr32);
-    mem->mapRW(NR33_ADDR, &m_nr33);
-    mem->mapRW(NR34_ADDR, &m_nr34);
-
-    mem->mapRW(W0_ADDR, &m_wave, sizeof(m_wave));
+    if (m_sweep_timer > 0 && --m_sweep_timer > 0)
+        return;
+
+    m_sweep_timer = m_nr10.sweep_time ? m_nr10.sweep_time : 8;
+    if (!m_sweep_enabled || m_nr10.sweep_time == 0)
+        return;
+
+    u16 freq = sweepFrequency();
+    if (freq <= 2047 && m_nr10.number_of_seep)
+    {
+        m_sweep_freq = freq;
+        m_nr13_nr14.freq = freq;
+        sweepFrequency();
+    }
 }
 
-void Apu::step(size_t clocks_diff)
+void Apu::onDivReset(size_t clocks)
 {
-    m_clocks += clocks_diff;
-    size_t sample_period = Timer::SYSTEM_FREQUENCY / AUDIO_SAMPLE_RATE;
+    catchUp(clocks);
+
+    // resetting DIV while bit 4 is set is a falling edge too
+    if (((clocks - m_div_start) / (FRAME_SEQ_PERIOD / 2)) & 1)
+        stepFrameSequencer();
+
+    m_div_start = clocks;
+    m_next_frame_seq = clocks + FRAME_SEQ_PERIOD;
+}
 
-    static size_t firstWrite = 0;
-    if (m_clocks >= sample_period)
+// The host audio clock never exactly matches the emulation speed, so the
+// output rate is nudged to keep the sink around its target fill level rather
+// than slowly drifting into underruns or overruns.
+void Apu::adjustRate()
+{
+    AudioStats stats = m_sink->stats();
+    f64 rate = AUDIO_SAMPLE_RATE;
+    if (stats.target != 0)
     {
-        // size_t sample_count = m_clocks / sample_period;
-        size_t sample_count = getDesiredBuffered() - getBuffered();
-        m_clocks %= sample_period;
+        f64 error = (static_cast<f64>(stats.target) - stats.buffered) /
+                    stats.target;
+        rate *= 1.0 + std::clamp(error, -1.0, 1.0) * MAX_RATE_DELTA;
+    }
 
-        decodeChannelPulseA(m_ch1_buffer + m_audio_buffer_size, sample_count);
-        decodeChannelPulseB(m_ch2_buffer + m_audio_buffer_size, sample_count);
-        decodeChannelWave(m_ch3_buffer + m_audio_buffer_size, sample_count);
+    // applies to the next frame
+    for (auto& blip : m_blips)
+        blip.setSampleRate(rate);
+}
 
-        // mix
-        for (size_t i = 0; i < sample_count * 2; i++)
-        {
-            s16 sample1 = m_ch1_buffer[m_audio_buffer_size + i];
-            s16 sample2 = m_ch2_buffer[m_audio_buffer_size + i];
-            s16 sample3 = m_ch3_buffer[m_audio_buffer_size + i];
-            s16 sample4 = m_ch4_buffer[m_audio_buffer_size + i];
-            m_audio_buffer[m_audio_buffer_size + i] =
-                (sample1 + sample2 + sample3) / 3;
-        }
+void Apu::onAudioEvent(size_t clocks)
+{
+    m_scheduler->schedule(EventType_Apu, clocks + SYNC_PERIOD);
 
-        m_audio_buffer_size += sample_count * 2; // 2 channels
+    catchUp(clocks);
 
-        // write out buffer
-        // if (m_audio_buffer_size + sample_count * 2 > AUDIO_BUFFER_SIZE)
-        {
-            play(m_audio_buffer, m_audio_buffer_size * sizeof(s16));
-            m_audio_buffer_size = 0;
-        }
+    size_t count = BLIP_CAPACITY;
+    const s16* channels[ChannelId_Count];
+    for (size_t i = 0; i < ChannelId_Count; i++)
+    {
+        m_blips[i].endFrame(clocks - m_frame_start);
+        count = m_blips[i].readSamples(m_channel_buffers[i], count);
+        channels[i] = m_channel_buffers[i];
     }
+    m_frame_start = clocks;
+
+    if (!m_sink)
+        return;
+
+    m_mixer.setRouting(*reinterpret_cast<u8*>(&m_nr50),
+                       *reinterpret_cast<u8*>(&m_nr51));
+    m_mixer.mix(channels, m_audio_buffer, count);
+    m_sink->write(m_audio_buffer, count);
+    adjustRate();
 }
 
 }
@@ -1,36 +1,87 @@
 #pragma once
 
+#include "blip_buffer.hpp"
 #include "device.hpp"
+#include "mixer.hpp"
+#include "result.hpp"
 
 namespace gbemu::core
 {
+
+class AudioSink;
+class Scheduler;
+
 static constexpr size_t AUDIO_SAMPLE_RATE = 44100;
 static constexpr size_t AUDIO_BUFFER_SIZE = 0x1000;
 
 class Apu : public Device
 {
 public:
-    Apu();
+    Apu(Scheduler* scheduler);
     ~Apu();
 
     virtual void mapMemory(Memory* mem) override;
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
 
-    void step(size_t clocks_diff);
-    void decodeChannelWave(s16* samples, size_t sample_count);
-    void decodeChannelPulseA(s16* samples, size_t sample_count);
-    void decodeChannelPulseB(s16* samples, size_t sample_count);
-    void decodeChannelNoise(s16* samples, size_t sample_count);
+    // scheduler event
+    void onAudioEvent(size_t clocks);
+    // the frame sequencer is clocked by DIV
+    void onDivReset(size_t clocks);
 
-    // backend
-    void initPlayer();
-    void destroyPlayer();
-    void play(const void* data, size_t size);
-    size_t getBuffered();
-    size_t getDesiredBuffered();
+    Result<u8> readRegister(u16 off);
+    Result<void> writeRegister(u16 off, u8 data);
+    Result<u8> readWave(u16 off);
+    Result<void> writeWave(u16 off, u8 data);
 
-    auto audioBuffer() { return m_audio_buffer; }
-    auto audioBufferSize() const { return m_audio_buffer_size; }
-    auto setAudioBufferSize(size_t new_size) { m_audio_buffer_size = new_size; }
+    // the channels still run without a sink, the samples are dropped
+    void setSink(AudioSink* sink) { m_sink = sink; }
+    AudioSink* sink() { return m_sink; }
+
+private:
+    enum ChannelId : u8
+    {
+        ChannelId_Pulse1,
+        ChannelId_Pulse2,
+        ChannelId_Wave,
+        ChannelId_Noise,
+
+        ChannelId_Count,
+    };
+
+    struct Channel
+    {
+        bool enabled;
+        u16 length;       // disables the channel when it reaches 0
+        size_t next_edge; // clock of the next frequency timer tick
+        u8 position;      // duty step or wave sample
+        u8 level;         // waveform output before the volume is applied
+        u8 volume;        // envelope
+        u8 envelope_timer;
+        s32 amplitude; // last value sent to the blip buffer
+    };
+
+    // state is only advanced up to `clocks` when something needs it
+    void catchUp(size_t clocks);
+    void runChannels(size_t clocks);
+    void runPulse(ChannelId id, size_t clocks);
+    void runWave(size_t clocks);
+    void runNoise(size_t clocks);
+
+    void stepFrameSequencer();
+    void clockLength();
+    void clockEnvelope();
+    void clockSweep();
+    u16 sweepFrequency();
+
+    void trigger(ChannelId id);
+    size_t timerPeriod(ChannelId id);
+    bool dacEnabled(ChannelId id);
+    u8* registerPtr(u16 addr);
+    void adjustRate();
+    void setAmplitude(ChannelId id, s32 value, size_t clocks);
+    // sends the channels' current output to the blip buffer
+    void updateOutputs(size_t clocks);
 
 private:
     struct
@@ -153,6 +204,27 @@ private:
         };
     } PACKED;
 
+    union WaveDacReg
+    {
+        u8 raw;
+        struct
+        {
+            u8 : 7;
+            u8 dac_enable : 1;
+        };
+    } PACKED;
+
+    union PolynomialReg
+    {
+        u8 raw;
+        struct
+        {
+            u8 divisor_code : 3;
+            u8 width_mode : 1; // 1 = 7 bits LFSR
+            u8 clock_shift : 4;
+        };
+    } PACKED;
+
     SweepReg m_nr10;
     LengthReg m_nr11;
     VolumeEnvelopReg m_nr12;
@@ -162,25 +234,38 @@ private:
     VolumeEnvelopReg m_nr22;
     DEFINE_NR_3_4(2);
 
+    WaveDacReg m_nr30;
     WaveLengthReg m_nr31;
     WaveVolumeReg m_nr32;
     DEFINE_NR_3_4(3);
 
+    LengthReg m_nr41;
+    VolumeEnvelopReg m_nr42;
+    PolynomialReg m_nr43;
+    ControlReg m_nr44;
+
     u8 m_wave[16];
 
-    s16 m_ch1_buffer[AUDIO_BUFFER_SIZE];
-    s16 m_ch2_buffer[AUDIO_BUFFER_SIZE];
-    s16 m_ch3_buffer[AUDIO_BUFFER_SIZE];
-    s16 m_ch4_buffer[AUDIO_BUFFER_SIZE];
-    s16 m_audio_buffer[AUDIO_BUFFER_SIZE];
-    size_t m_audio_buffer_size;
+    Channel m_channels[ChannelId_Count];
+    u16 m_sweep_freq; // channel 1 shadow frequency
+    u8 m_sweep_timer;
+    bool m_sweep_enabled;
+    u16 m_lfsr;
+
+    size_t m_clocks;         // the state is up to date up to there
+    size_t m_div_start;      // last DIV reset
+    size_t m_next_frame_seq; // clock of the next frame sequencer step
+    u8 m_frame_seq_step;
 
-    size_t m_clocks;
+    // one per channel so they can be routed separately
+    BlipBuffer m_blips[ChannelId_Count];
+    size_t m_frame_start; // clock of the start of the current blip frame
+    s16 m_channel_buffers[ChannelId_Count][AUDIO_BUFFER_SIZE / 2];
+    Mixer m_mixer;
+    s16 m_audio_buffer[AUDIO_BUFFER_SIZE];
 
-    f64 m_ch1_prev_x = 0;
-    f64 m_ch2_prev_x = 0;
-    f64 m_ch3_prev_x = 0;
-    f64 m_ch4_prev_x = 0;
+    Scheduler* m_scheduler;
+    AudioSink* m_sink;
 };
 
 }
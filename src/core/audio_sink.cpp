@@ -0,0 +1,42 @@
+#include "audio_sink.hpp"
+#include <algorithm>
+
+namespace gbemu::core
+{
+
+RingAudioSink::RingAudioSink(size_t capacity, size_t target) :
+    m_ring(capacity * 2),
+    m_overruns(0),
+    m_underruns(0),
+    m_target(target)
+{
+}
+
+void RingAudioSink::write(const s16* samples, size_t count)
+{
+    size_t written = m_ring.write(samples, count * 2) / 2;
+    if (written != count)
+        m_overruns.fetch_add(count - written, std::memory_order_relaxed);
+}
+
+AudioStats RingAudioSink::stats() const
+{
+    return {
+        m_ring.size() / 2,
+        m_overruns.load(std::memory_order_relaxed),
+        m_underruns.load(std::memory_order_relaxed),
+        m_target,
+    };
+}
+
+void RingAudioSink::read(s16* samples, size_t count)
+{
+    size_t read = m_ring.read(samples, count * 2) / 2;
+    if (read == count)
+        return;
+
+    std::fill_n(samples + read * 2, (count - read) * 2, 0);
+    m_underruns.fetch_add(count - read, std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>
+#include "types.hpp"
+#include "common/ring_buffer.hpp"
+#include "backend.hpp"
+
+namespace gbemu::core
+{
+
+// Queues the samples for a backend draining them from its own thread (e.g. an
+// audio callback), the emulation side never blocks nor queries the device.
+class RingAudioSink : public AudioSink
+{
+public:
+    // capacity in stereo samples, the emulation adjusts its output rate to
+    // keep `target` samples buffered if not 0
+    RingAudioSink(size_t capacity, size_t target = 0);
+
+    virtual void write(const s16* samples, size_t count) override;
+    virtual AudioStats stats() const override;
+
+    // backend side, pads with silence if not enough samples are available
+    void read(s16* samples, size_t count);
+
+private:
+    RingBuffer<s16> m_ring; // interleaved, always accessed by pairs
+    std::atomic<u64> m_overruns;
+    std::atomic<u64> m_underruns;
+    size_t m_target;
+};
+
+}
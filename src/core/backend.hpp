@@ -0,0 +1,70 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace gbemu::core
+{
+
+struct IndexedFrame;
+
+// Interfaces implemented by the frontends. The core only ever talks to the
+// audio sink, video and input are driven by the frontend's main loop.
+
+class VideoBackend
+{
+public:
+    virtual ~VideoBackend() = default;
+
+    // converting the frame to RGBA is up to the backend
+    virtual void present(const IndexedFrame& frame) = 0;
+};
+
+struct AudioStats
+{
+    size_t buffered;  // stereo samples waiting to be played
+    u64 overruns;     // stereo samples dropped because the sink was full
+    u64 underruns;    // stereo samples of silence played because it was empty
+    size_t target;    // fill level the sink wants to be kept at, 0 if none
+};
+
+class AudioSink
+{
+public:
+    virtual ~AudioSink() = default;
+
+    // count interleaved stereo samples, called from the emulation thread.
+    // Real-time sinks must never block, offline ones (e.g. capture) may wait
+    // for their consumer rather than drop samples.
+    virtual void write(const s16* samples, size_t count) = 0;
+
+    virtual AudioStats stats() const { return {}; }
+};
+
+class InputBackend
+{
+public:
+    virtual ~InputBackend() = default;
+
+    // JoypadButton mask of the buttons currently held
+    virtual u8 poll() = 0;
+};
+
+class NullVideoBackend : public VideoBackend
+{
+public:
+    virtual void present(const IndexedFrame& frame) override {}
+};
+
+class NullAudioSink : public AudioSink
+{
+public:
+    virtual void write(const s16* samples, size_t count) override {}
+};
+
+class NullInputBackend : public InputBackend
+{
+public:
+    virtual u8 poll() override { return 0; }
+};
+
+}
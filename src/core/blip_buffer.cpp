@@ -0,0 +1,115 @@
+#include "blip_buffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include "save_state.hpp"
+
+namespace gbemu::core
+{
+
+// fraction of the output Nyquist frequency kept by the kernel
+static constexpr f64 KERNEL_CUTOFF = 0.9;
+
+const BlipBuffer::Kernel BlipBuffer::s_kernel = BlipBuffer::makeKernel();
+
+BlipBuffer::BlipBuffer(size_t clock_rate, size_t sample_rate,
+                       size_t capacity) :
+    m_clock_rate(clock_rate),
+    m_factor((static_cast<u64>(sample_rate) << 32) / clock_rate),
+    m_offset(0),
+    m_integrator(0),
+    m_buffer(capacity + TAPS, 0)
+{
+}
+
+BlipBuffer::Kernel BlipBuffer::makeKernel()
+{
+    using std::numbers::pi;
+    Kernel kernel;
+
+    // windowed sinc impulse for each sub-sample phase, the output integrates
+    // them back into band-limited steps
+    for (size_t phase = 0; phase < PHASES; phase++)
+    {
+        f64 frac = static_cast<f64>(phase) / PHASES;
+        f64 taps[TAPS];
+        f64 sum = 0;
+
+        for (size_t i = 0; i < TAPS; i++)
+        {
+            f64 x = i - (TAPS / 2.0 - 1.0) - frac;
+            f64 y = KERNEL_CUTOFF * pi * x;
+            f64 sinc = x == 0 ? 1.0 : std::sin(y) / y;
+            // blackman
+            f64 w = (x + TAPS / 2.0) / TAPS;
+            f64 window = 0.42 - 0.5 * std::cos(2 * pi * w) +
+                         0.08 * std::cos(4 * pi * w);
+            taps[i] = sinc * window;
+            sum += taps[i];
+        }
+
+        // each phase must add up to exactly one step
+        s32 total = 0;
+        for (size_t i = 0; i < TAPS; i++)
+        {
+            f64 tap = taps[i] / sum * (1 << KERNEL_BITS);
+            kernel[phase][i] = std::lround(tap);
+            total += kernel[phase][i];
+        }
+        kernel[phase][TAPS / 2 - 1] += (1 << KERNEL_BITS) - total;
+    }
+
+    return kernel;
+}
+
+void BlipBuffer::endFrame(size_t clocks)
+{
+    m_offset += clocks * m_factor;
+}
+
+void BlipBuffer::setSampleRate(f64 sample_rate)
+{
+    m_factor = static_cast<u64>(sample_rate / m_clock_rate * (1ull << 32));
+}
+
+void BlipBuffer::saveState(StateWriter& state, size_t samples)
+{
+    samples = std::min(samples, m_buffer.size());
+    state.write(m_factor);
+    state.write(m_offset);
+    state.write(m_integrator);
+    state.write(m_buffer.data(), samples * sizeof(s32));
+}
+
+void BlipBuffer::loadState(StateReader& state, size_t samples)
+{
+    samples = std::min(samples, m_buffer.size());
+    state.read(m_factor);
+    state.read(m_offset);
+    state.read(m_integrator);
+    std::fill(m_buffer.begin() + samples, m_buffer.end(), 0);
+    state.read(m_buffer.data(), samples * sizeof(s32));
+}
+
+size_t BlipBuffer::readSamples(s16* out, size_t count, size_t stride)
+{
+    count = std::min(count, samplesAvailable());
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_integrator += m_buffer[i];
+        s32 sample = m_integrator >> KERNEL_BITS;
+        out[i * stride] = std::clamp<s32>(sample, INT16_MIN, INT16_MAX);
+    }
+
+    // drop the samples read, keeping the tails of the pending steps
+    size_t used = samplesAvailable() + TAPS;
+    std::copy(m_buffer.begin() + count, m_buffer.begin() + used,
+              m_buffer.begin());
+    std::fill(m_buffer.begin() + used - count, m_buffer.begin() + used, 0);
+    m_offset -= static_cast<u64>(count) << 32;
+
+    return count;
+}
+
+}
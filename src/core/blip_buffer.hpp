@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include "types.hpp"
+
+namespace gbemu::core
+{
+
+class StateReader;
+class StateWriter;
+
+// Band-limited synthesis buffer. Channels only report the clock and size of
+// each amplitude change, which is spread over a few output samples with a
+// windowed sinc step instead of being point sampled, so square waves don't
+// alias. Everything is integer / fixed-point.
+class BlipBuffer
+{
+public:
+    static constexpr size_t PHASE_BITS = 5;
+    static constexpr size_t PHASES = 1 << PHASE_BITS;
+    static constexpr size_t TAPS = 16;
+    static constexpr size_t KERNEL_BITS = 12;
+
+public:
+    // capacity is the max number of samples buffered between reads
+    BlipBuffer(size_t clock_rate, size_t sample_rate, size_t capacity);
+
+    // clocks are relative to the start of the current frame
+    void addDelta(size_t clocks, s32 delta)
+    {
+        u64 pos = m_offset + clocks * m_factor;
+        size_t phase = (pos >> (32 - PHASE_BITS)) & (PHASES - 1);
+
+        s32* dst = &m_buffer[pos >> 32];
+        const s16* kernel = s_kernel[phase].data();
+        for (size_t i = 0; i < TAPS; i++)
+            dst[i] += kernel[i] * delta;
+    }
+    // the samples up to the end of the frame become readable
+    void endFrame(size_t clocks);
+    // only use between two frames, the pending deltas keep their position
+    void setSampleRate(f64 sample_rate);
+
+    size_t samplesAvailable() const { return m_offset >> 32; }
+    // writes one sample every `stride` s16
+    size_t readSamples(s16* out, size_t count, size_t stride = 1);
+
+    // Only the start of the buffer is saved, `samples` must cover all the
+    // readable samples and pending steps so that the state stays fixed size.
+    void saveState(StateWriter& state, size_t samples);
+    void loadState(StateReader& state, size_t samples);
+
+private:
+    size_t m_clock_rate;
+    u64 m_factor; // samples per clock, 32.32
+    u64 m_offset; // start of the current frame in samples, 32.32
+    s32 m_integrator;
+    std::vector<s32> m_buffer;
+
+    using Kernel = std::array<std::array<s16, TAPS>, PHASES>;
+    // only depends on the constants above, shared by every buffer
+    static const Kernel s_kernel;
+    static Kernel makeKernel();
+};
+
+}
@@ -0,0 +1,181 @@
+#include "capture_sink.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "macro.hpp"
+#include "apu.hpp"
+
+namespace gbemu::core
+{
+
+// stereo samples, ~370ms
+static constexpr size_t CAPTURE_CAPACITY = 0x4000;
+// the writer waits for at least that many stereo samples
+static constexpr size_t BLOCK_SIZE = 0x1000;
+
+struct WaveHeader
+{
+    char riff_magic[4];    // "RIFF"
+    u32 wave_section_size; // -8
+    char wave_magic[4];    // "WAVE"
+    char fmt_magic[4];     // "fmt "
+    u32 header_size;
+    u16 format; // PCM=1
+    u16 channel_count;
+    u32 sample_rate;
+    u32 stride;
+    u16 byte_rate;
+    u16 bits_per_sample;
+    char data_magic[4]; // "data"
+    u32 data_section_size;
+} PACKED;
+
+File::Result<std::unique_ptr<CaptureAudioSink>>
+CaptureAudioSink::open(const fs::path& path, CaptureFormat format)
+{
+    std::ofstream file;
+    file.open(path, std::ios::binary);
+
+    ERROR_IF(!file.is_open(), FileSystemError_FileOpenFailed);
+
+    return std::unique_ptr<CaptureAudioSink>(
+        new CaptureAudioSink(std::move(file), format));
+}
+
+CaptureAudioSink::CaptureAudioSink(std::ofstream file, CaptureFormat format) :
+    m_file(std::move(file)),
+    m_format(format),
+    m_ring(CAPTURE_CAPACITY * 2),
+    m_closing(false),
+    m_failed(false),
+    m_written(0)
+{
+    // sizes are patched on close
+    writeHeader(0);
+    m_thread = std::thread(&CaptureAudioSink::writerThread, this);
+}
+
+CaptureAudioSink::~CaptureAudioSink()
+{
+    close();
+}
+
+File::Result<void> CaptureAudioSink::close()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_closing = true;
+        }
+        m_cond.notify_all();
+        m_thread.join();
+
+        if (!m_failed)
+        {
+            m_file.seekp(0);
+            writeHeader(m_written);
+            m_file.close();
+            m_failed = m_file.fail();
+        }
+    }
+
+    ERROR_IF(m_failed, FileSystemError_WriteFailed);
+    return {};
+}
+
+void CaptureAudioSink::writeHeader(u64 samples)
+{
+    if (m_format != CaptureFormat_Wav)
+        return;
+
+    size_t byte_per_sample = 2;
+    size_t channel_count = 2;
+    // RIFF sizes are 32 bits, ~6 hours of audio
+    u64 data_size = std::min<u64>(samples * byte_per_sample * channel_count,
+                                  UINT32_MAX - sizeof(WaveHeader));
+
+    WaveHeader header;
+    std::memcpy(header.riff_magic, "RIFF", 4);
+    header.wave_section_size = sizeof(header) + data_size - 8;
+    std::memcpy(header.wave_magic, "WAVE", 4);
+    std::memcpy(header.fmt_magic, "fmt ", 4);
+    header.header_size = 0x10;
+    header.format = 1; // PCM
+    header.channel_count = channel_count;
+    header.sample_rate = AUDIO_SAMPLE_RATE;
+    header.stride = AUDIO_SAMPLE_RATE * byte_per_sample * channel_count;
+    header.byte_rate = byte_per_sample * channel_count;
+    header.bits_per_sample = byte_per_sample * 8;
+    std::memcpy(header.data_magic, "data", 4);
+    header.data_section_size = data_size;
+
+    m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void CaptureAudioSink::notify()
+{
+    {
+        std::lock_guard lock(m_mutex);
+    }
+    m_cond.notify_all();
+}
+
+void CaptureAudioSink::write(const s16* samples, size_t count)
+{
+    while (true)
+    {
+        size_t written = m_ring.write(samples, count * 2) / 2;
+        samples += written * 2;
+        count -= written;
+
+        if (m_ring.size() >= BLOCK_SIZE * 2)
+            notify();
+        if (count == 0)
+            return;
+
+        // the writer is behind, wait for it to free some space
+        std::unique_lock lock(m_mutex);
+        m_cond.wait(lock,
+                    [&] { return m_ring.size() < m_ring.capacity(); });
+    }
+}
+
+AudioStats CaptureAudioSink::stats() const
+{
+    return { m_ring.size() / 2, 0, 0, 0 };
+}
+
+void CaptureAudioSink::writerThread()
+{
+    std::vector<s16> block(BLOCK_SIZE * 2);
+
+    while (true)
+    {
+        bool closing;
+        {
+            std::unique_lock lock(m_mutex);
+            m_cond.wait(lock, [&]
+                        { return m_closing || m_ring.size() >= block.size(); });
+            closing = m_closing;
+        }
+
+        size_t count = m_ring.read(block.data(), block.size());
+        notify();
+
+        // keeps draining after a failure so that write() never gets stuck
+        if (!m_failed)
+        {
+            m_file.write(reinterpret_cast<const char*>(block.data()),
+                         count * sizeof(s16));
+            m_failed = m_file.fail();
+            if (!m_failed)
+                m_written += count / 2;
+        }
+
+        if (closing && m_ring.size() == 0)
+            break;
+    }
+}
+
+}
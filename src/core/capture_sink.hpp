@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "types.hpp"
+#include "common/fs.hpp"
+#include "common/ring_buffer.hpp"
+#include "backend.hpp"
+
+namespace gbemu::core
+{
+
+enum CaptureFormat
+{
+    CaptureFormat_Wav,
+    CaptureFormat_Raw, // interleaved s16 stereo, no header
+};
+
+// Streams the audio to a file from a background thread so only a bounded
+// amount of samples is ever held in memory. Unlike the real-time sinks,
+// `write` waits for the writer if it falls a whole buffer behind, so no
+// sample is ever dropped.
+class CaptureAudioSink : public AudioSink
+{
+public:
+    static File::Result<std::unique_ptr<CaptureAudioSink>>
+    open(const fs::path& path, CaptureFormat format);
+    ~CaptureAudioSink();
+
+    // flushes the pending samples and patches the WAV header, nothing can be
+    // written afterwards. Fails if any write did not make it to the file
+    // (e.g. the disk is full), later calls return the same result.
+    File::Result<void> close();
+
+    virtual void write(const s16* samples, size_t count) override;
+    virtual AudioStats stats() const override;
+
+    // stereo samples successfully written to the file so far
+    u64 samplesWritten() const { return m_written; }
+
+private:
+    CaptureAudioSink(std::ofstream file, CaptureFormat format);
+
+    void writerThread();
+    void writeHeader(u64 samples);
+    // wakes up the other side, taking the lock so the wakeup can't be missed
+    void notify();
+
+    std::ofstream m_file;
+    CaptureFormat m_format;
+    RingBuffer<s16> m_ring;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_closing;
+    bool m_failed; // owned by the writer thread until it is joined
+    std::atomic<u64> m_written;
+    std::thread m_thread;
+};
+
+}
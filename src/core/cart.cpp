@@ -1,4 +1,5 @@
 #include "cart.hpp"
+#include <algorithm>
 #include "unit.hpp"
 #include "common/logging.hpp"
 #include "io.hpp"
@@ -69,18 +70,83 @@ const char* CartHeader::cartType(CartridgeType cart_type)
     }
 }
 
-Cart::Cart(std::vector<u8> rom) : m_rom(rom), m_header(data<const CartHeader>())
+static std::vector<u8> padRom(std::vector<u8> rom)
+{
+    rom.resize(std::max(rom.size(), MIN_ROM_SIZE));
+
+    auto header = reinterpret_cast<const CartHeader*>(rom.data());
+    if (header->rom_size <= 9)
+        rom.resize(std::max(rom.size(), header->romSize()));
+
+    return rom;
+}
+
+static bool isSupported(CartridgeType type)
+{
+    switch (type)
+    {
+        case CartridgeType_ROM:
+        case CartridgeType_MBC1:
+        case CartridgeType_MBC1_RAM:
+        case CartridgeType_MBC1_RAM_BATTERY:
+        case CartridgeType_MBC3:
+        case CartridgeType_MBC3_RAM:
+        case CartridgeType_MBC3_RAM_BATTERY:
+        case CartridgeType_MBC3_TIMER_BATTERY:
+        case CartridgeType_MBC3_TIMER_RAM_BATTERY: return true;
+        default: return false;
+    }
+}
+
+Cart::Cart(std::vector<u8> rom) :
+    Cart(std::make_shared<const std::vector<u8>>(padRom(std::move(rom))))
+{
+}
+
+Result<std::unique_ptr<Cart>> Cart::open(std::shared_ptr<const MappedFile> rom,
+                                         bool persistent)
+{
+    auto ret = validate(rom->bytes());
+    if (!ret)
+        return tl::make_unexpected(ret.error());
+
+    auto bytes = rom->bytes();
+    return std::unique_ptr<Cart>(new Cart(std::move(rom), bytes, persistent));
+}
+
+Result<void> Cart::validate(std::span<const u8> rom)
+{
+    // anything shorter would be mapped past its end
+    ERROR_IF(rom.size() < MIN_ROM_SIZE, CartError_RomTooSmall);
+
+    auto header = reinterpret_cast<const CartHeader*>(rom.data());
+    ERROR_IF(header->rom_size > 9, CartError_InvalidRomSize);
+    ERROR_IF(rom.size() < header->romSize(), CartError_RomTooSmall);
+    ERROR_IF(!isSupported(header->cart_type), CartError_UnsupportedType);
+
+    return {};
+}
+
+Cart::Cart(std::shared_ptr<const std::vector<u8>> rom) : Cart(rom, *rom, true)
+{
+}
+
+Cart::Cart(std::shared_ptr<const void> owner, std::span<const u8> rom,
+           bool persistent) :
+    m_owner(std::move(owner)),
+    m_rom(rom),
+    m_header(data<const CartHeader>())
 {
     switch (m_header->cart_type)
     {
         case CartridgeType_ROM:
-            m_mbc = std::unique_ptr<Mbc>(new Rom(m_rom));
+            m_mbc = std::unique_ptr<Mbc>(new Rom(m_rom, persistent));
             break;
 
         case CartridgeType_MBC1:
         case CartridgeType_MBC1_RAM:
         case CartridgeType_MBC1_RAM_BATTERY:
-            m_mbc = std::unique_ptr<Mbc>(new Mbc1(m_rom));
+            m_mbc = std::unique_ptr<Mbc>(new Mbc1(m_rom, persistent));
             break;
 
         case CartridgeType_MBC3:
@@ -88,7 +154,7 @@ Cart::Cart(std::vector<u8> rom) : m_rom(rom), m_header(data<const CartHeader>())
         case CartridgeType_MBC3_RAM_BATTERY:
         case CartridgeType_MBC3_TIMER_BATTERY:
         case CartridgeType_MBC3_TIMER_RAM_BATTERY:
-            m_mbc = std::unique_ptr<Mbc>(new Mbc3(m_rom));
+            m_mbc = std::unique_ptr<Mbc>(new Mbc3(m_rom, persistent));
             break;
 
         default:
@@ -97,6 +163,11 @@ Cart::Cart(std::vector<u8> rom) : m_rom(rom), m_header(data<const CartHeader>())
     }
 }
 
+std::unique_ptr<Cart> Cart::fork() const
+{
+    return std::unique_ptr<Cart>(new Cart(m_owner, m_rom, false));
+}
+
 void Cart::mapMemory(Memory* mem, bool bootrom_enabled)
 {
     // map the part of the cartridge that doesn't overlap with the bootrom
@@ -1,19 +1,27 @@
 #pragma once
 
 #include <bits/unique_ptr.h>
+#include <memory>
+#include <span>
 #include <vector>
 #include "attributes.hpp"
 #include "types.hpp"
 #include "unit.hpp"
+#include "common/fs.hpp"
+#include "memory.hpp"
 #include "result.hpp"
 
 namespace gbemu::core
 {
 
 class Memory;
+class StateReader;
+class StateWriter;
 
 static constexpr size_t ROM_BANK_SIZE = 16_kb;
 static constexpr size_t RAM_BANK_SIZE = 8_kb;
+// two banks, the smallest cartridges
+static constexpr size_t MIN_ROM_SIZE = 2 * ROM_BANK_SIZE;
 
 enum CartridgeType : u8
 {
@@ -93,54 +101,102 @@ static_assert(sizeof(CartHeader) == 0x150);
 class Mbc
 {
 public:
-    Mbc(const std::vector<u8>& rom) : m_rom(rom) {}
+    // without persistence, the external RAM is never loaded from or saved
+    // to disk
+    Mbc(std::span<const u8> rom, bool persistent) :
+        m_rom(rom),
+        m_persistent(persistent)
+    {
+    }
     virtual ~Mbc(){};
 
     virtual void map(Memory* mem) = 0;
 
+    // banking registers and external RAM, the ROM is not part of the state
+    virtual void saveState(StateWriter& state) {}
+    virtual void loadState(StateReader& state) {}
+
     auto header() const
     {
         return reinterpret_cast<const CartHeader*>(m_rom.data());
     }
 
 protected:
-    template<typename T, typename... TArgs>
-    auto writeFunc(auto func, TArgs... args)
+    // bank numbers wrap around the banks actually present
+    const u8* romBank(size_t bank) const
+    {
+        size_t bank_count = m_rom.size() / ROM_BANK_SIZE;
+        return m_rom.data() + (bank % bank_count) * ROM_BANK_SIZE;
+    }
+
+    // Handlers calling T::Func(mem, off, ...) with the memory passed to map()
+    template<auto Func, typename T>
+    MmioWriteHandler writeFunc()
     {
-        return std::bind(func, reinterpret_cast<T*>(this),
-                         std::forward<TArgs>(args)..., std::placeholders::_1,
-                         std::placeholders::_2);
+        return { [](void* ctx, u16 off, u8 data) -> Result<void>
+                 {
+                     T* mbc = static_cast<T*>(ctx);
+                     return (mbc->*Func)(mbc->Mbc::m_mem, off, data);
+                 },
+                 static_cast<T*>(this) };
     }
-    template<typename T, typename... TArgs>
-    auto readFunc(auto func, TArgs... args)
+    template<auto Func, typename T>
+    MmioReadHandler readFunc()
     {
-        return std::bind(func, reinterpret_cast<T*>(this),
-                         std::forward<TArgs>(args)..., std::placeholders::_1);
+        return { [](void* ctx, u16 off) -> Result<u8>
+                 {
+                     T* mbc = static_cast<T*>(ctx);
+                     return (mbc->*Func)(mbc->Mbc::m_mem, off);
+                 },
+                 static_cast<T*>(this) };
     }
 
 protected:
-    const std::vector<u8>& m_rom;
+    std::span<const u8> m_rom;
+    bool m_persistent;
+    Memory* m_mem = nullptr;
 };
 
 class Cart
 {
 public:
+    // the missing banks read as zeros
     Cart(std::vector<u8> rom);
 
+    // Reads the ROM straight from the mapping, no copy is made. Fails if the
+    // file can't hold the banks the header asks for. Without persistence,
+    // the save file is never touched.
+    static Result<std::unique_ptr<Cart>> open(
+        std::shared_ptr<const MappedFile> rom, bool persistent = true);
+    static Result<void> validate(std::span<const u8> rom);
+
+    // Shares the ROM, the MBC starts over and must be restored from a save
+    // state. Forks never touch the save file.
+    std::unique_ptr<Cart> fork() const;
+
 public:
     template<typename T = void>
-    T* data(size_t off = 0)
+    const T* data(size_t off = 0) const
     {
-        return reinterpret_cast<T*>(m_rom.data() + off);
+        return reinterpret_cast<const T*>(m_rom.data() + off);
     }
 
     void mapMemory(Memory* mem, bool bootrom_enabled);
+    void saveState(StateWriter& state) { m_mbc->saveState(state); }
+    void loadState(StateReader& state) { m_mbc->loadState(state); }
 
     auto header() const { return m_header; }
-    auto& rom() { return m_rom; };
+    std::span<const u8> rom() const { return m_rom; };
+
+private:
+    Cart(std::shared_ptr<const std::vector<u8>> rom);
+    // `owner` keeps the ROM alive, it is shared with every fork
+    Cart(std::shared_ptr<const void> owner, std::span<const u8> rom,
+         bool persistent);
 
 private:
-    std::vector<u8> m_rom;
+    std::shared_ptr<const void> m_owner;
+    std::span<const u8> m_rom;
     const CartHeader* m_header;
     std::unique_ptr<Mbc> m_mbc;
 };
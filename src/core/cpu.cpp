@@ -6,6 +6,9 @@
 #include "io.hpp"
 #include "memory.hpp"
 #include "opcode.hpp"
+#include "optable.hpp"
+#include "save_state.hpp"
+#include "scheduler.hpp"
 #include "timer.hpp"
 
 #define TRACE(...)                                                             \
@@ -20,11 +23,14 @@
 namespace gbemu::core
 {
 
-Cpu::Cpu(Memory* memory, Timer* timer, InterruptController* interrupt) :
+Cpu::Cpu(Memory* memory, Timer* timer, InterruptController* interrupt,
+         Scheduler* scheduler) :
     m_memory(memory),
     m_timer(timer),
     m_interrupt_controller(interrupt),
-    m_logging_enable(false)
+    m_scheduler(scheduler),
+    m_logging_enable(false),
+    m_clocks(0)
 {
     reset();
 }
@@ -40,6 +46,20 @@ void Cpu::reset()
     m_halted = false;
 }
 
+void Cpu::saveState(StateWriter& state)
+{
+    state.write(m_regs);
+    state.write(m_halted);
+    state.write(m_clocks);
+}
+
+void Cpu::loadState(StateReader& state)
+{
+    state.read(m_regs);
+    state.read(m_halted);
+    state.read(m_clocks);
+}
+
 void Cpu::step()
 {
     TRACE("step : PC={:04X}\n", regs().pc);
@@ -47,15 +67,30 @@ void Cpu::step()
     if (m_halted)
     {
         // TODO: ?
-        m_timer->tick(4);
+        tick(4);
         return;
     }
 
     u16 ins_addr = regs().pc;
 
+    if (m_logging_enable)
+    {
+        u8 mem[3];
+        mem[0] = m_memory->read8(regs().pc + 0).value_or(0);
+        mem[1] = m_memory->read8(regs().pc + 1).value_or(0);
+        mem[2] = m_memory->read8(regs().pc + 2).value_or(0);
+
+        TRACE("{:04X}: {}\n", regs().pc, Disas::disassemble(&mem, sizeof(mem)));
+    }
+
+    size_t start = m_clocks;
     u8 op = fetch8();
 
-    execute(op);
+    (this->*s_ops[op])();
+
+#ifdef CHECK_CYCLES
+    assert(matchesOpInfo(ins_addr, op, m_clocks - start));
+#endif
 
     // if (op == OP_JR_r8 && m_memory->read8(ins_addr+1) == 0xFE)
     //     UNREACHABLE("INFINITY LOOP AT PC={:04X}", regs().pc);
@@ -74,9 +109,39 @@ void Cpu::step()
 // 10 : passed
 // 11 : passed
 
+// OP_INFO is the reference for the timings but the cycles are still charged
+// by each memory access rather than once per instruction: an I/O register
+// has to see the devices as they are on the exact M-cycle of the access
+// (timer, LY and STAT polling). Charging the whole instruction up front or
+// at the end would move every such access by several M-cycles. Instead,
+// builds with CHECK_CYCLES (all but the LTO ones) check every instruction
+// against the table, which costs an extra read for the CB opcodes.
+bool Cpu::matchesOpInfo(u16 addr, u8 op, size_t clocks)
+{
+    if (op == OP_HALT || op == OP_STOP_d8)
+        return true;
+
+    const OpInfo* info = &OP_INFO[op];
+    if (op == OP_PREFIX)
+        info = &CB_OP_INFO[m_memory->read8(addr + 1).value_or(0)];
+
+    return clocks == info->cycles || clocks == info->cycles_branch;
+}
+
+void Cpu::syncIo(u16 addr)
+{
+    // registers are only up to date once the devices have caught up
+    if (addr >= IO_START && addr < IO_END)
+    {
+        m_scheduler->sync(m_clocks);
+        m_timer->sync(m_clocks);
+    }
+}
+
 u8 Cpu::read8(u16 addr)
 {
-    m_timer->tick(4);
+    tick(4);
+    syncIo(addr);
     auto ret = mem()->read8(addr);
     TRACE("read(0x{:04X})={:02X}\n", addr, ret.value_or(0));
 
@@ -94,7 +159,8 @@ u8 Cpu::read8(u16 addr)
 
 void Cpu::write8(u16 addr, u8 x)
 {
-    m_timer->tick(4);
+    tick(4);
+    syncIo(addr);
     auto ret = mem()->write8(addr, x);
     TRACE("write8(0x{:04X}, 0x{:02X})\n", addr, x);
 
@@ -136,14 +202,13 @@ u16 Cpu::fetch16()
 
 void Cpu::push16(u16 x)
 {
-    m_timer->tick(4);
+    tick(4);
     regs().sp -= 2;
     write16(regs().sp, x);
 }
 
 u16 Cpu::pop16()
 {
-    m_timer->tick(4);
     u16 ret = read16(regs().sp);
     regs().sp += 2;
     return ret;
@@ -196,33 +261,83 @@ void Cpu::writeReg(VREG8 reg, u8 data)
     }
 }
 
-#define LD(d, s)                                                               \
-    op_ld(VREG8_##d, VREG8_##s);                                               \
-    break
-#define INC(r)                                                                 \
-    op_inc(VREG8_##r);                                                         \
-    break
-#define DEC(r)                                                                 \
-    op_dec(VREG8_##r);                                                         \
-    break
-#define PUSH(x)                                                                \
-    push16(regs().x);                                                          \
-    break
-#define POP(x)                                                                 \
-    regs().x = pop16();                                                        \
-    break
-#define CALL_A16(cond)                                                         \
-    op_call(cond, fetch16());                                                  \
-    break
-#define RET(cond)                                                              \
-    op_ret(cond);                                                              \
-    break
-#define JR_R8(cond)                                                            \
-    op_jr(cond, fetch8());                                                     \
-    break
-#define JP_A16(cond)                                                           \
-    op_jp(cond, fetch16());                                                    \
-    break
+template<Cpu::VREG8 reg>
+ALWAYS_INLINE inline u8 Cpu::readReg()
+{
+    if constexpr (reg == VREG8_B)
+        return regs().b;
+    else if constexpr (reg == VREG8_C)
+        return regs().c;
+    else if constexpr (reg == VREG8_D)
+        return regs().d;
+    else if constexpr (reg == VREG8_E)
+        return regs().e;
+    else if constexpr (reg == VREG8_H)
+        return regs().h;
+    else if constexpr (reg == VREG8_L)
+        return regs().l;
+    else if constexpr (reg == VREG8_HL8)
+        return read8(regs().hl);
+    else if constexpr (reg == VREG8_A)
+        return regs().a;
+    else if constexpr (reg == VREG8_HLI)
+        return read8(regs().hl++);
+    else if constexpr (reg == VREG8_HLD)
+        return read8(regs().hl--);
+    else if constexpr (reg == VREG8_BC8)
+        return read8(regs().bc);
+    else if constexpr (reg == VREG8_DE8)
+        return read8(regs().de);
+    else if constexpr (reg == VREG8_HA8)
+        return read8(IO_START + fetch8());
+    else if constexpr (reg == VREG8_HC)
+        return read8(IO_START + regs().c);
+    else if constexpr (reg == VREG8_A16)
+        return read8(fetch16());
+    else
+    {
+        static_assert(reg == VREG8_D8, "Invalid VREG8");
+        return fetch8();
+    }
+}
+
+template<Cpu::VREG8 reg>
+ALWAYS_INLINE inline void Cpu::writeReg(u8 data)
+{
+    if constexpr (reg == VREG8_B)
+        regs().b = data;
+    else if constexpr (reg == VREG8_C)
+        regs().c = data;
+    else if constexpr (reg == VREG8_D)
+        regs().d = data;
+    else if constexpr (reg == VREG8_E)
+        regs().e = data;
+    else if constexpr (reg == VREG8_H)
+        regs().h = data;
+    else if constexpr (reg == VREG8_L)
+        regs().l = data;
+    else if constexpr (reg == VREG8_HL8)
+        write8(regs().hl, data);
+    else if constexpr (reg == VREG8_A)
+        regs().a = data;
+    else if constexpr (reg == VREG8_HLI)
+        write8(regs().hl++, data);
+    else if constexpr (reg == VREG8_HLD)
+        write8(regs().hl--, data);
+    else if constexpr (reg == VREG8_BC8)
+        write8(regs().bc, data);
+    else if constexpr (reg == VREG8_DE8)
+        write8(regs().de, data);
+    else if constexpr (reg == VREG8_HA8)
+        write8(IO_START + fetch8(), data);
+    else if constexpr (reg == VREG8_HC)
+        write8(IO_START + regs().c, data);
+    else
+    {
+        static_assert(reg == VREG8_A16, "Invalid VREG8");
+        write8(fetch16(), data);
+    }
+}
 
 #define Z regs().flags.z
 #define NZ !regs().flags.z
@@ -231,612 +346,751 @@ void Cpu::writeReg(VREG8 reg, u8 data)
 #define N regs().flags.n
 #define H regs().flags.h
 
-#define MAKE_OP1(start, size, func, ...)                                       \
-    if (op >= start && op < start + size)                                      \
-    {                                                                          \
-        VREG8 r = (VREG8)((op - start) % 8);                                   \
-        func(r, ##__VA_ARGS__);                                                \
-        return;                                                                \
+void Cpu::opJr(bool cond, s8 n)
+{
+    if (cond)
+    {
+        tick(4);
+        regs().pc += n;
     }
+}
 
-#define MAKE_OP_ACCU(start, size, func, ...)                                   \
-    if (op >= start && op < start + size)                                      \
-    {                                                                          \
-        VREG8 src = (VREG8)((op - start) % 8);                                 \
-        func(VREG8_A, src, ##__VA_ARGS__);                                     \
-        return;                                                                \
+void Cpu::opJp(bool cond, u16 addr)
+{
+    if (cond)
+    {
+        tick(4);
+        regs().pc = addr;
     }
+}
 
-#define MAKE_OP_LD(start, size, func, ...)                                     \
-    if (op >= start && op < start + size)                                      \
-    {                                                                          \
-        VREG8 dst = (VREG8)((op - start) / 8);                                 \
-        VREG8 src = (VREG8)((op - start) % 8);                                 \
-        func(dst, src, ##__VA_ARGS__);                                         \
-        return;                                                                \
-    }
+void Cpu::opRet()
+{
+    regs().pc = pop16();
+    tick(4);
+}
 
-#define MAKE_OP_IDX(start, size, func, ...)                                    \
-    if (op >= start && op <= start + size - 1)                                 \
-    {                                                                          \
-        u8 idx = (op - start) / 8;                                             \
-        VREG8 r = (VREG8)((op - start) % 8);                                   \
-        func(r, idx, ##__VA_ARGS__);                                           \
-        return;                                                                \
-    }
+void Cpu::opRet(bool cond)
+{
+    tick(4);
+    if (cond)
+        opRet();
+}
 
-void Cpu::execute(u8 op)
+void Cpu::opCall(bool cond, u16 addr)
 {
-    auto op_jr = [this](bool cond, s8 n) ALWAYS_INLINE
+    if (cond)
     {
-        if (cond)
-        {
-            m_timer->tick(4);
-            regs().pc += n;
-        }
-    };
-    auto op_jp = [this](bool cond, u16 addr) ALWAYS_INLINE
-    {
-        if (cond)
-        {
-            m_timer->tick(4);
-            regs().pc = addr;
-        }
-    };
+        push16(regs().pc);
+        regs().pc = addr;
+    }
+}
 
-    auto op_ret = [this](bool cond) ALWAYS_INLINE
-    {
-        m_timer->tick(4);
-        if (cond)
-        {
-            regs().pc = pop16();
-        }
-    };
+void Cpu::opAddHl(u16 a)
+{
+    tick(4);
 
-    auto op_call = [this](bool cond, u16 addr) ALWAYS_INLINE
-    {
-        if (cond)
-        {
-            push16(regs().pc);
-            regs().pc = addr;
-        }
-    };
+    u16 b = regs().hl;
+    u16 d = a + b;
 
-    auto op_ld = [this](VREG8 dst, VREG8 src) ALWAYS_INLINE
-    { writeReg(dst, readReg(src)); };
+    // https://newbedev.com/game-boy-half-carry-flag-and-16-bit-instructions-especially-opcode-0xe8
+    N = 0;
+    H = !!(((a & 0xFFF) + (b & 0xFFF)) & (1 << 12));
+    C = d < a + b;
 
-    auto op_add_hl_r16 = [this](u16 a) ALWAYS_INLINE
-    {
-        m_timer->tick(4);
+    regs().hl = d;
+}
 
-        u16 b = regs().hl;
-        u16 d = a + b;
+template<Cpu::VREG8 dst, Cpu::VREG8 src>
+ALWAYS_INLINE inline void Cpu::opLd()
+{
+    writeReg<dst>(readReg<src>());
+}
 
-        // https://newbedev.com/game-boy-half-carry-flag-and-16-bit-instructions-especially-opcode-0xe8
-        N = 0;
-        H = !!(((a & 0xFFF) + (b & 0xFFF)) & (1 << 12));
-        C = d < a + b;
+template<Cpu::VREG8 dst, Cpu::VREG8 src, bool c>
+ALWAYS_INLINE inline void Cpu::opAdd()
+{
+    u8 a = readReg<dst>();
+    u8 b = readReg<src>();
+    u8 e = (c && regs().flags.c) ? 1 : 0;
+    u8 d = a + b + e;
 
-        regs().hl = d;
-    };
+    Z = d == 0;
+    N = 0;
+    H = !!(((a & 0xF) + (b & 0xF) + e) & 0x10);
+    C = d < (a + b + e);
 
-    auto op_add = [this](VREG8 dst, VREG8 src, bool c) ALWAYS_INLINE
-    {
-        u8 a = readReg(dst);
-        u8 b = readReg(src);
-        u8 e = (c && regs().flags.c) ? 1 : 0;
-        u8 d = a + b + e;
+    writeReg<dst>(d);
+}
 
-        Z = d == 0;
-        N = 0;
-        H = !!(((a & 0xF) + (b & 0xF) + e) & 0x10);
-        C = d < (a + b + e);
+template<Cpu::VREG8 dst, Cpu::VREG8 src, bool c>
+ALWAYS_INLINE inline void Cpu::opSub()
+{
+    u8 a = readReg<dst>();
+    u8 b = readReg<src>();
+    u8 e = (c && regs().flags.c) ? 1 : 0;
+    u8 d = a - b - e;
+
+    Z = d == 0;
+    N = 1;
+    H = !!(((a & 0xF) - (b & 0xF) - e) & 0x10);
+    C = d > (a - b - e);
+
+    writeReg<dst>(d);
+}
+
+template<Cpu::VREG8 dst, Cpu::VREG8 src>
+ALWAYS_INLINE inline void Cpu::opAnd()
+{
+    u8 a = readReg<dst>();
+    u8 b = readReg<src>();
+    u8 d = a & b;
+
+    Z = d == 0;
+    N = 0;
+    H = 1;
+    C = 0;
+
+    writeReg<dst>(d);
+}
+
+template<Cpu::VREG8 dst, Cpu::VREG8 src>
+ALWAYS_INLINE inline void Cpu::opXor()
+{
+    u8 a = readReg<dst>();
+    u8 b = readReg<src>();
+    u8 d = a ^ b;
+
+    Z = d == 0;
+    N = 0;
+    H = 0;
+    C = 0;
+
+    writeReg<dst>(d);
+}
+
+template<Cpu::VREG8 dst, Cpu::VREG8 src>
+ALWAYS_INLINE inline void Cpu::opOr()
+{
+    u8 a = readReg<dst>();
+    u8 b = readReg<src>();
+    u8 d = a | b;
 
-        writeReg(dst, d);
-    };
-    auto op_sub = [this](VREG8 dst, VREG8 src, bool c) ALWAYS_INLINE
+    Z = d == 0;
+    N = 0;
+    H = 0;
+    C = 0;
+
+    writeReg<dst>(d);
+}
+
+template<Cpu::VREG8 dst, Cpu::VREG8 src>
+ALWAYS_INLINE inline void Cpu::opCp()
+{
+    u8 a = readReg<dst>();
+    u8 b = readReg<src>();
+    u8 d = a - b;
+
+    Z = d == 0;
+    N = 1;
+    H = !!(((a & 0xF) - (b & 0xF)) & 0x10);
+    C = d > a - b;
+}
+
+template<Cpu::VREG8 r>
+ALWAYS_INLINE inline void Cpu::opInc()
+{
+    u8 a = readReg<r>();
+    u8 b = 1;
+    u8 d = a + b;
+
+    Z = d == 0;
+    N = 0;
+    H = !!(((a & 0xF) + b) & 0x10);
+
+    writeReg<r>(d);
+}
+
+template<Cpu::VREG8 r>
+ALWAYS_INLINE inline void Cpu::opDec()
+{
+    u8 a = readReg<r>();
+    u8 b = 1;
+    u8 d = a - b;
+
+    Z = d == 0;
+    N = 1;
+    H = !!(((a & 0xF) - b) & 0x10);
+
+    writeReg<r>(d);
+}
+
+#define LD(d, s) opLd<VREG8_##d, VREG8_##s>()
+#define INC(r) opInc<VREG8_##r>()
+#define DEC(r) opDec<VREG8_##r>()
+#define INC16(x) (tick(4), regs().x++)
+#define DEC16(x) (tick(4), regs().x--)
+#define PUSH(x) push16(regs().x)
+#define POP(x) regs().x = pop16()
+#define CALL_A16(cond) opCall(cond, fetch16())
+#define RET(cond) opRet(cond)
+#define JR_R8(cond) opJr(cond, fetch8())
+#define JP_A16(cond) opJp(cond, fetch16())
+#define RST(addr) opCall(true, addr)
+
+// register operand encoded in the lower 3 bits of the opcode
+#define OP_REG(op) ((VREG8)((op) % 8))
+#define IS_OP(op, start, size) ((op) >= (start) && (op) < (start) + (size))
+
+template<u8 op>
+void Cpu::execute()
+{
+    // LD
+    if constexpr (IS_OP(op, OP_LD_B_B, 0x40) && op != OP_HALT)
+        opLd<(VREG8)((op - OP_LD_B_B) / 8), OP_REG(op)>();
+
+    else if constexpr (IS_OP(op, OP_ADD_A_B, 8))
+        opAdd<VREG8_A, OP_REG(op), false>();
+    else if constexpr (IS_OP(op, OP_ADC_A_B, 8))
+        opAdd<VREG8_A, OP_REG(op), true>();
+    else if constexpr (IS_OP(op, OP_SUB_B, 8))
+        opSub<VREG8_A, OP_REG(op), false>();
+    else if constexpr (IS_OP(op, OP_SBC_A_B, 8))
+        opSub<VREG8_A, OP_REG(op), true>();
+    else if constexpr (IS_OP(op, OP_AND_B, 8))
+        opAnd<VREG8_A, OP_REG(op)>();
+    else if constexpr (IS_OP(op, OP_XOR_B, 8))
+        opXor<VREG8_A, OP_REG(op)>();
+    else if constexpr (IS_OP(op, OP_OR_B, 8))
+        opOr<VREG8_A, OP_REG(op)>();
+    else if constexpr (IS_OP(op, OP_CP_B, 8))
+        opCp<VREG8_A, OP_REG(op)>();
+
+    else if constexpr (op == OP_NOP)
+    {
+    }
+    else if constexpr (op == OP_STOP_d8)
+    {
+        // UNIMPLEMENTED("STOP");
+        // TODO:
+        LOG("***STOP***\n");
+        fetch8();
+    }
+    else if constexpr (op == OP_HALT)
     {
-        u8 a = readReg(dst);
-        u8 b = readReg(src);
-        u8 e = (c && regs().flags.c) ? 1 : 0;
-        u8 d = a - b - e;
+        // TODO: halt bug
+        m_halted = true;
+    }
 
-        Z = d == 0;
-        N = 1;
-        H = !!(((a & 0xF) - (b & 0xF) - e) & 0x10);
-        C = d > (a - b - e);
+    else if constexpr (op == OP_JR_NZ_r8)
+        JR_R8(NZ);
+    else if constexpr (op == OP_JR_NC_r8)
+        JR_R8(NC);
+    else if constexpr (op == OP_JR_r8)
+        JR_R8(true);
+    else if constexpr (op == OP_JR_Z_r8)
+        JR_R8(Z);
+    else if constexpr (op == OP_JR_C_r8)
+        JR_R8(C);
+
+    else if constexpr (op == OP_CALL_a16)
+        CALL_A16(true);
+    else if constexpr (op == OP_CALL_NZ_a16)
+        CALL_A16(NZ);
+    else if constexpr (op == OP_CALL_NC_a16)
+        CALL_A16(NC);
+    else if constexpr (op == OP_CALL_Z_a16)
+        CALL_A16(Z);
+    else if constexpr (op == OP_CALL_C_a16)
+        CALL_A16(C);
+
+    else if constexpr (op == OP_PUSH_BC)
+        PUSH(bc);
+    else if constexpr (op == OP_PUSH_DE)
+        PUSH(de);
+    else if constexpr (op == OP_PUSH_HL)
+        PUSH(hl);
+    else if constexpr (op == OP_PUSH_AF)
+        PUSH(af);
+
+    else if constexpr (op == OP_POP_BC)
+        POP(bc);
+    else if constexpr (op == OP_POP_DE)
+        POP(de);
+    else if constexpr (op == OP_POP_HL)
+        POP(hl);
+    else if constexpr (op == OP_POP_AF)
+    {
+        regs().af = pop16();
+        regs().f &= 0xF0;
+    }
 
-        writeReg(dst, d);
-    };
-    auto op_and = [this](VREG8 dst, VREG8 src) ALWAYS_INLINE
+    else if constexpr (op == OP_LD_BC_d16)
+        regs().bc = fetch16();
+    else if constexpr (op == OP_LD_DE_d16)
+        regs().de = fetch16();
+    else if constexpr (op == OP_LD_HL_d16)
+        regs().hl = fetch16();
+    else if constexpr (op == OP_LD_SP_d16)
+        regs().sp = fetch16();
+
+    else if constexpr (op == OP_LD_SP_HL)
     {
-        u8 a = readReg(dst);
-        u8 b = readReg(src);
-        u8 d = a & b;
+        tick(4);
+        regs().sp = regs().hl;
+    }
 
-        Z = d == 0;
-        N = 0;
-        H = 1;
-        C = 0;
+    else if constexpr (op == OP_RST_00H)
+        RST(0x00);
+    else if constexpr (op == OP_RST_08H)
+        RST(0x08);
+    else if constexpr (op == OP_RST_10H)
+        RST(0x10);
+    else if constexpr (op == OP_RST_18H)
+        RST(0x18);
+    else if constexpr (op == OP_RST_20H)
+        RST(0x20);
+    else if constexpr (op == OP_RST_28H)
+        RST(0x28);
+    else if constexpr (op == OP_RST_30H)
+        RST(0x30);
+    else if constexpr (op == OP_RST_38H)
+        RST(0x38);
+
+    else if constexpr (op == OP_LD_MEM_BC_A)
+        LD(BC8, A);
+    else if constexpr (op == OP_LD_MEM_DE_A)
+        LD(DE8, A);
+    else if constexpr (op == OP_LD_MEM_HLI_A)
+        LD(HLI, A);
+    else if constexpr (op == OP_LD_MEM_HLD_A)
+        LD(HLD, A);
+
+    else if constexpr (op == OP_LD_B_d8)
+        LD(B, D8);
+    else if constexpr (op == OP_LD_D_d8)
+        LD(D, D8);
+    else if constexpr (op == OP_LD_H_d8)
+        LD(H, D8);
+    else if constexpr (op == OP_LD_MEM_HL_d8)
+        LD(HL8, D8);
+
+    else if constexpr (op == OP_LD_A_MEM_BC)
+        LD(A, BC8);
+    else if constexpr (op == OP_LD_A_MEM_DE)
+        LD(A, DE8);
+    else if constexpr (op == OP_LD_A_MEM_HLI)
+        LD(A, HLI);
+    else if constexpr (op == OP_LD_A_MEM_HLD)
+        LD(A, HLD);
+
+    else if constexpr (op == OP_LD_C_d8)
+        LD(C, D8);
+    else if constexpr (op == OP_LD_E_d8)
+        LD(E, D8);
+    else if constexpr (op == OP_LD_L_d8)
+        LD(L, D8);
+    else if constexpr (op == OP_LD_A_d8)
+        LD(A, D8);
+
+    else if constexpr (op == OP_INC_B)
+        INC(B);
+    else if constexpr (op == OP_INC_D)
+        INC(D);
+    else if constexpr (op == OP_INC_H)
+        INC(H);
+    else if constexpr (op == OP_INC_MEM_HL)
+        INC(HL8);
+    else if constexpr (op == OP_INC_C)
+        INC(C);
+    else if constexpr (op == OP_INC_E)
+        INC(E);
+    else if constexpr (op == OP_INC_L)
+        INC(L);
+    else if constexpr (op == OP_INC_A)
+        INC(A);
+
+    else if constexpr (op == OP_DEC_B)
+        DEC(B);
+    else if constexpr (op == OP_DEC_D)
+        DEC(D);
+    else if constexpr (op == OP_DEC_H)
+        DEC(H);
+    else if constexpr (op == OP_DEC_MEM_HL)
+        DEC(HL8);
+    else if constexpr (op == OP_DEC_C)
+        DEC(C);
+    else if constexpr (op == OP_DEC_E)
+        DEC(E);
+    else if constexpr (op == OP_DEC_L)
+        DEC(L);
+    else if constexpr (op == OP_DEC_A)
+        DEC(A);
+
+    else if constexpr (op == OP_INC_BC)
+        INC16(bc);
+    else if constexpr (op == OP_INC_DE)
+        INC16(de);
+    else if constexpr (op == OP_INC_HL)
+        INC16(hl);
+    else if constexpr (op == OP_INC_SP)
+        INC16(sp);
+    else if constexpr (op == OP_DEC_BC)
+        DEC16(bc);
+    else if constexpr (op == OP_DEC_DE)
+        DEC16(de);
+    else if constexpr (op == OP_DEC_HL)
+        DEC16(hl);
+    else if constexpr (op == OP_DEC_SP)
+        DEC16(sp);
+
+    else if constexpr (op == OP_RET_Z)
+        RET(Z);
+    else if constexpr (op == OP_RET_C)
+        RET(C);
+    else if constexpr (op == OP_RET)
+        opRet();
+    else if constexpr (op == OP_RET_NZ)
+        RET(NZ);
+    else if constexpr (op == OP_RET_NC)
+        RET(NC);
+    else if constexpr (op == OP_RETI)
+    {
+        m_interrupt_controller->setIME(true);
+        opRet();
+    }
 
-        writeReg(dst, d);
-    };
-    auto op_xor = [this](VREG8 dst, VREG8 src) ALWAYS_INLINE
+    else if constexpr (op == OP_CP_d8)
+        opCp<VREG8_A, VREG8_D8>();
+
+    else if constexpr (op == OP_LD_MEM_a16_A)
+        LD(A16, A);
+    else if constexpr (op == OP_LD_A_MEM_a16)
+        LD(A, A16);
+
+    else if constexpr (op == OP_LD_MEM_a16_SP)
+        write16(fetch16(), regs().sp);
+
+    else if constexpr (op == OP_RLCA)
     {
-        u8 a = readReg(dst);
-        u8 b = readReg(src);
-        u8 d = a ^ b;
+        bool new_c = regs().a >> 7;
+        regs().a <<= 1;
+        regs().a |= new_c;
 
-        Z = d == 0;
+        Z = 0;
         N = 0;
         H = 0;
-        C = 0;
-
-        writeReg(dst, d);
-    };
-    auto op_or = [this](VREG8 dst, VREG8 src) ALWAYS_INLINE
+        C = new_c;
+    }
+    else if constexpr (op == OP_RLA)
     {
-        u8 a = readReg(dst);
-        u8 b = readReg(src);
-        u8 d = a | b;
+        bool new_c = regs().a >> 7;
+        regs().a <<= 1;
+        regs().a |= C;
 
-        Z = d == 0;
+        Z = 0;
         N = 0;
         H = 0;
-        C = 0;
-
-        writeReg(dst, d);
-    };
-    auto op_cp = [this](VREG8 dst, VREG8 src) ALWAYS_INLINE
+        C = new_c;
+    }
+    else if constexpr (op == OP_RRCA)
     {
-        u8 a = readReg(dst);
-        u8 b = readReg(src);
-        u8 d = a - b;
+        bool new_c = regs().a & 1;
 
-        Z = d == 0;
-        N = 1;
-        H = !!(((a & 0xF) - (b & 0xF)) & 0x10);
-        C = d > a - b;
-    };
+        regs().a >>= 1;
+        regs().a |= new_c << 7;
 
-    auto op_inc = [this](VREG8 r) ALWAYS_INLINE
+        Z = 0;
+        N = 0;
+        H = 0;
+        C = new_c;
+    }
+    else if constexpr (op == OP_RRA)
     {
-        u8 a = readReg(r);
-        u8 b = 1;
-        u8 d = a + b;
+        bool new_c = regs().a & 1;
 
-        Z = d == 0;
-        N = 0;
-        H = !!(((a & 0xF) + b) & 0x10);
+        regs().a >>= 1;
+        regs().a |= C << 7;
 
-        writeReg(r, d);
-    };
+        Z = 0;
+        N = 0;
+        H = 0;
+        C = new_c;
+    }
 
-    auto op_dec = [this](VREG8 r) ALWAYS_INLINE
+    else if constexpr (op == OP_LDH_MEM_a8_A)
+        LD(HA8, A);
+    else if constexpr (op == OP_LDH_A_MEM_a8)
+        LD(A, HA8);
+
+    else if constexpr (op == OP_LD_MEM_C_A)
+        LD(HC, A);
+    else if constexpr (op == OP_LD_A_MEM_C)
+        LD(A, HC);
+
+    else if constexpr (op == OP_PREFIX)
+        (this->*s_cb_ops[fetch8()])();
+
+    else if constexpr (op == OP_DI)
+        m_interrupt_controller->setIME(false);
+    else if constexpr (op == OP_EI)
+        m_interrupt_controller->setIME(true);
+
+    else if constexpr (op == OP_JP_a16)
+        JP_A16(true);
+    else if constexpr (op == OP_JP_Z_a16)
+        JP_A16(Z);
+    else if constexpr (op == OP_JP_NZ_a16)
+        JP_A16(NZ);
+    else if constexpr (op == OP_JP_C_a16)
+        JP_A16(C);
+    else if constexpr (op == OP_JP_NC_a16)
+        JP_A16(NC);
+    else if constexpr (op == OP_JP_HL)
+        regs().pc = regs().hl;
+
+    else if constexpr (op == OP_ADD_HL_BC)
+        opAddHl(regs().bc);
+    else if constexpr (op == OP_ADD_HL_DE)
+        opAddHl(regs().de);
+    else if constexpr (op == OP_ADD_HL_HL)
+        opAddHl(regs().hl);
+    else if constexpr (op == OP_ADD_HL_SP)
+        opAddHl(regs().sp);
+
+    else if constexpr (op == OP_ADD_A_d8)
+        opAdd<VREG8_A, VREG8_D8, false>();
+    else if constexpr (op == OP_ADC_A_d8)
+        opAdd<VREG8_A, VREG8_D8, true>();
+    else if constexpr (op == OP_SUB_d8)
+        opSub<VREG8_A, VREG8_D8, false>();
+    else if constexpr (op == OP_SBC_A_d8)
+        opSub<VREG8_A, VREG8_D8, true>();
+
+    else if constexpr (op == OP_AND_d8)
     {
-        u8 a = readReg(r);
-        u8 b = 1;
-        u8 d = a - b;
-
-        Z = d == 0;
-        N = 1;
-        H = !!(((a & 0xF) - b) & 0x10);
-
-        writeReg(r, d);
-    };
+        regs().a &= fetch8();
+        Z = regs().a == 0;
+        N = 0;
+        H = 1;
+        C = 0;
+    }
+    else if constexpr (op == OP_OR_d8)
+    {
+        regs().a |= fetch8();
+        Z = regs().a == 0;
+        N = 0;
+        H = 0;
+        C = 0;
+    }
+    else if constexpr (op == OP_XOR_d8)
+    {
+        regs().a ^= fetch8();
+        Z = regs().a == 0;
+        N = 0;
+        H = 0;
+        C = 0;
+    }
 
-    // LD
-    if (op != OP_HALT)
-        MAKE_OP_LD(OP_LD_B_B, 0x40, op_ld);
-
-    MAKE_OP_ACCU(OP_ADD_A_B, 8, op_add, false);
-    MAKE_OP_ACCU(OP_ADC_A_B, 8, op_add, true);
-    MAKE_OP_ACCU(OP_SUB_B, 8, op_sub, false);
-    MAKE_OP_ACCU(OP_SBC_A_B, 8, op_sub, true);
-    MAKE_OP_ACCU(OP_AND_B, 8, op_and);
-    MAKE_OP_ACCU(OP_XOR_B, 8, op_xor);
-    MAKE_OP_ACCU(OP_OR_B, 8, op_or);
-    MAKE_OP_ACCU(OP_CP_B, 8, op_cp);
-
-    u8 mem[3];
-    mem[0] = op;
-    mem[1] = m_memory->read8(regs().pc + 0).value_or(0);
-    mem[2] = m_memory->read8(regs().pc + 1).value_or(0);
-
-    TRACE("{:04X}: {}\n", regs().pc - 1, Disas::disassemble(&mem, sizeof(mem)));
-
-    switch (op)
+    else if constexpr (op == OP_DAA)
     {
-        case OP_NOP: break;
-        case OP_STOP_d8:
-            // UNIMPLEMENTED("STOP");
-            // TODO:
-            LOG("***STOP***\n");
-            fetch8();
-            break;
-        case OP_HALT:
-            // TODO: halt bug
-            m_halted = true;
-            break;
-
-        case OP_JR_NZ_r8: JR_R8(NZ);
-        case OP_JR_NC_r8: JR_R8(NC);
-        case OP_JR_r8: JR_R8(true);
-        case OP_JR_Z_r8: JR_R8(Z);
-        case OP_JR_C_r8: JR_R8(C);
-
-        case OP_CALL_a16: CALL_A16(true);
-        case OP_CALL_NZ_a16: CALL_A16(NZ);
-        case OP_CALL_NC_a16: CALL_A16(NC);
-        case OP_CALL_Z_a16: CALL_A16(Z);
-        case OP_CALL_C_a16: CALL_A16(C);
-
-        case OP_PUSH_BC: PUSH(bc);
-        case OP_PUSH_DE: PUSH(de);
-        case OP_PUSH_HL: PUSH(hl);
-        case OP_PUSH_AF: PUSH(af);
-
-        case OP_POP_BC: POP(bc);
-        case OP_POP_DE: POP(de);
-        case OP_POP_HL: POP(hl);
-        case OP_POP_AF:
-            regs().af = pop16();
-            regs().f &= 0xF0;
-            break;
-
-        case OP_LD_BC_d16: regs().bc = fetch16(); break;
-        case OP_LD_DE_d16: regs().de = fetch16(); break;
-        case OP_LD_HL_d16: regs().hl = fetch16(); break;
-        case OP_LD_SP_d16: regs().sp = fetch16(); break;
-
-        case OP_LD_SP_HL:
-            m_timer->tick(4);
-            regs().sp = regs().hl;
-            break;
-
-        case OP_RST_00H: op_call(true, 0x00); break;
-        case OP_RST_08H: op_call(true, 0x08); break;
-        case OP_RST_10H: op_call(true, 0x10); break;
-        case OP_RST_18H: op_call(true, 0x18); break;
-        case OP_RST_20H: op_call(true, 0x20); break;
-        case OP_RST_28H: op_call(true, 0x28); break;
-        case OP_RST_30H: op_call(true, 0x30); break;
-        case OP_RST_38H: op_call(true, 0x38); break;
-
-        case OP_LD_MEM_BC_A: LD(BC8, A);
-        case OP_LD_MEM_DE_A: LD(DE8, A);
-        case OP_LD_MEM_HLI_A: LD(HLI, A);
-        case OP_LD_MEM_HLD_A: LD(HLD, A);
-
-        case OP_LD_B_d8: LD(B, D8);
-        case OP_LD_D_d8: LD(D, D8);
-        case OP_LD_H_d8: LD(H, D8);
-        case OP_LD_MEM_HL_d8: LD(HL8, D8);
-
-        case OP_LD_A_MEM_BC: LD(A, BC8);
-        case OP_LD_A_MEM_DE: LD(A, DE8);
-        case OP_LD_A_MEM_HLI: LD(A, HLI);
-        case OP_LD_A_MEM_HLD: LD(A, HLD);
-
-        case OP_LD_C_d8: LD(C, D8);
-        case OP_LD_E_d8: LD(E, D8);
-        case OP_LD_L_d8: LD(L, D8);
-        case OP_LD_A_d8: LD(A, D8);
-
-        case OP_INC_B: INC(B);
-        case OP_INC_D: INC(D);
-        case OP_INC_H: INC(H);
-        case OP_INC_MEM_HL: INC(HL8);
-        case OP_INC_C: INC(C);
-        case OP_INC_E: INC(E);
-        case OP_INC_L: INC(L);
-        case OP_INC_A: INC(A);
-
-        case OP_DEC_B: DEC(B);
-        case OP_DEC_D: DEC(D);
-        case OP_DEC_H: DEC(H);
-        case OP_DEC_MEM_HL: DEC(HL8);
-        case OP_DEC_C: DEC(C);
-        case OP_DEC_E: DEC(E);
-        case OP_DEC_L: DEC(L);
-        case OP_DEC_A: DEC(A);
-
-        case OP_INC_BC: regs().bc++; break;
-        case OP_INC_DE: regs().de++; break;
-        case OP_INC_HL: regs().hl++; break;
-        case OP_INC_SP: regs().sp++; break;
-        case OP_DEC_BC: regs().bc--; break;
-        case OP_DEC_DE: regs().de--; break;
-        case OP_DEC_HL: regs().hl--; break;
-        case OP_DEC_SP: regs().sp--; break;
-
-        case OP_RET_Z: RET(Z);
-        case OP_RET_C: RET(C);
-        case OP_RET: RET(true);
-        case OP_RET_NZ: RET(NZ);
-        case OP_RET_NC: RET(NC);
-        case OP_RETI: m_interrupt_controller->setIME(true); RET(true);
-
-        case OP_CP_d8: op_cp(VREG8_A, VREG8_D8); break;
-
-        case OP_LD_MEM_a16_A: LD(A16, A);
-        case OP_LD_A_MEM_a16: LD(A, A16);
-
-        case OP_LD_MEM_a16_SP: write16(fetch16(), regs().sp); break;
-
-        case OP_RLCA:
+        if (!N)
         {
-            bool new_c = regs().a >> 7;
-            regs().a <<= 1;
-            regs().a |= new_c;
-
-            Z = 0;
-            N = 0;
-            H = 0;
-            C = new_c;
-            break;
-        }
-        case OP_RLA:
-        {
-            bool new_c = regs().a >> 7;
-            regs().a <<= 1;
-            regs().a |= C;
-
-            Z = 0;
-            N = 0;
-            H = 0;
-            C = new_c;
-            break;
-        }
-        case OP_RRCA:
-        {
-            bool new_c = regs().a & 1;
-
-            regs().a >>= 1;
-            regs().a |= new_c << 7;
+            if (C || regs().a > 0x99)
+            {
+                regs().a += 0x60;
+                C = 1;
+            }
 
-            Z = 0;
-            N = 0;
-            H = 0;
-            C = new_c;
-            break;
+            if (H || (regs().a & 0x0F) > 0x09)
+                regs().a += 0x6;
         }
-        case OP_RRA:
+        else
         {
-            bool new_c = regs().a & 1;
-
-            regs().a >>= 1;
-            regs().a |= C << 7;
-
-            Z = 0;
-            N = 0;
-            H = 0;
-            C = new_c;
-            break;
-        }
-
-        case OP_LDH_MEM_a8_A: LD(HA8, A);
-        case OP_LDH_A_MEM_a8: LD(A, HA8);
-
-        case OP_LD_MEM_C_A: LD(HC, A);
-        case OP_LD_A_MEM_C: LD(A, HC);
-
-        case OP_PREFIX: executeCB(fetch8()); break;
-
-        case OP_DI: // DI
-            m_interrupt_controller->setIME(false);
-            break;
-        case OP_EI: // EI
-            m_interrupt_controller->setIME(true);
-            break;
-
-        case OP_JP_a16: JP_A16(true);
-        case OP_JP_Z_a16: JP_A16(Z);
-        case OP_JP_NZ_a16: JP_A16(NZ);
-        case OP_JP_C_a16: JP_A16(C);
-        case OP_JP_NC_a16: JP_A16(NC);
-        case OP_JP_HL: regs().pc = regs().hl; break;
-
-        case OP_ADD_HL_BC: op_add_hl_r16(regs().bc); break;
-        case OP_ADD_HL_DE: op_add_hl_r16(regs().de); break;
-        case OP_ADD_HL_HL: op_add_hl_r16(regs().hl); break;
-        case OP_ADD_HL_SP: op_add_hl_r16(regs().sp); break;
-
-        case OP_ADD_A_d8: op_add(VREG8_A, VREG8_D8, false); break;
-        case OP_ADC_A_d8: op_add(VREG8_A, VREG8_D8, true); break;
-        case OP_SUB_d8: op_sub(VREG8_A, VREG8_D8, false); break;
-        case OP_SBC_A_d8: op_sub(VREG8_A, VREG8_D8, true); break;
-
-        case OP_AND_d8:
-            regs().a &= fetch8();
-            Z = regs().a == 0;
-            N = 0;
-            H = 1;
-            C = 0;
-            break;
-
-        case OP_OR_d8:
-            regs().a |= fetch8();
-            Z = regs().a == 0;
-            N = 0;
-            H = 0;
-            C = 0;
-            break;
-
-        case OP_XOR_d8:
-            regs().a ^= fetch8();
-            Z = regs().a == 0;
-            N = 0;
-            H = 0;
-            C = 0;
-            break;
-
-        case OP_DAA:
-            if (!N)
+            if (C)
             {
-                if (C || regs().a > 0x99)
-                {
-                    regs().a += 0x60;
-                    C = 1;
-                }
-
-                if (H || (regs().a & 0x0F) > 0x09)
-                    regs().a += 0x6;
-            }
-            else
-            {
-                if (C)
-                {
-                    regs().a -= 0x60;
-                    C = 1;
-                }
-                if (H)
-                    regs().a -= 0x6;
+                regs().a -= 0x60;
+                C = 1;
             }
+            if (H)
+                regs().a -= 0x6;
+        }
 
-            Z = regs().a == 0;
-            H = 0;
-            break;
-        case OP_SCF:
-            N = 0;
-            H = 0;
-            C = 1;
-            break;
-        case OP_CPL:
-            regs().a ^= 0xFF;
-            N = 1;
-            H = 1;
-            break;
-        case OP_CCF:
-            N = 0;
-            H = 0;
-            C = !C;
-            break;
-
-        case OP_ADD_SP_r8:
-        {
-            m_timer->tick(8);
+        Z = regs().a == 0;
+        H = 0;
+    }
+    else if constexpr (op == OP_SCF)
+    {
+        N = 0;
+        H = 0;
+        C = 1;
+    }
+    else if constexpr (op == OP_CPL)
+    {
+        regs().a ^= 0xFF;
+        N = 1;
+        H = 1;
+    }
+    else if constexpr (op == OP_CCF)
+    {
+        N = 0;
+        H = 0;
+        C = !C;
+    }
 
-            u16 a = regs().sp;
-            s16 b = (s8)fetch8();
-            u16 d = a + b;
+    else if constexpr (op == OP_ADD_SP_r8)
+    {
+        tick(8);
 
-            Z = 0;
-            N = 0;
-            H = !!(((a & 0xF) + (b & 0xF)) & 0x10);
-            C = !!(((a & 0xFF) + (b & 0xFF)) & 0x100);
+        u16 a = regs().sp;
+        s16 b = (s8)fetch8();
+        u16 d = a + b;
 
-            regs().sp = d;
-            break;
-        }
+        Z = 0;
+        N = 0;
+        H = !!(((a & 0xF) + (b & 0xF)) & 0x10);
+        C = !!(((a & 0xFF) + (b & 0xFF)) & 0x100);
 
-        case OP_LD_HL_SPI_r8:
-        {
-            m_timer->tick(4);
+        regs().sp = d;
+    }
 
-            u16 a = regs().sp;
-            u16 b = (s8)fetch8();
-            u16 d = a + b;
+    else if constexpr (op == OP_LD_HL_SPI_r8)
+    {
+        tick(4);
 
-            Z = 0;
-            N = 0;
-            H = !!(((a & 0xF) + (b & 0xF)) & 0x10);
-            C = !!(((a & 0xFF) + (b & 0xFF)) & 0x100);
+        u16 a = regs().sp;
+        u16 b = (s8)fetch8();
+        u16 d = a + b;
 
-            regs().hl = d;
-            break;
-        }
+        Z = 0;
+        N = 0;
+        H = !!(((a & 0xF) + (b & 0xF)) & 0x10);
+        C = !!(((a & 0xFF) + (b & 0xFF)) & 0x100);
 
-        default: UNIMPLEMENTED("Unimplemented opcode (0x{:02X})", op);
+        regs().hl = d;
     }
+
+    else
+        UNIMPLEMENTED("Unimplemented opcode (0x{:02X})", op);
 }
 
-void Cpu::executeCB(u8 op)
+template<Cpu::VREG8 r, size_t idx>
+ALWAYS_INLINE inline void Cpu::opBit()
 {
-    auto op_bit = [this](VREG8 r, size_t idx) ALWAYS_INLINE
-    {
-        u8 b = readReg(r);
-
-        Z = (b & (1 << idx)) == 0;
-        N = 0;
-        H = 1;
-    };
-
-    auto op_res = [this](VREG8 r, size_t idx) ALWAYS_INLINE
-    {
-        u8 b = readReg(r);
-        b &= ~(1 << idx);
-        writeReg(r, b);
-    };
+    u8 b = readReg<r>();
 
-    auto op_set = [this](VREG8 r, size_t idx) ALWAYS_INLINE
-    {
-        u8 b = readReg(r);
-        b |= 1 << idx;
-        writeReg(r, b);
-    };
+    Z = (b & (1 << idx)) == 0;
+    N = 0;
+    H = 1;
+}
 
-    auto op_sr = [this]<typename T>(VREG8 r, bool c, bool rotate) ALWAYS_INLINE
-    {
-        T b = readReg(r);
+template<Cpu::VREG8 r, size_t idx>
+ALWAYS_INLINE inline void Cpu::opRes()
+{
+    u8 b = readReg<r>();
+    b &= ~(1 << idx);
+    writeReg<r>(b);
+}
 
-        bool new_c = b & 1;
+template<Cpu::VREG8 r, size_t idx>
+ALWAYS_INLINE inline void Cpu::opSet()
+{
+    u8 b = readReg<r>();
+    b |= 1 << idx;
+    writeReg<r>(b);
+}
 
-        b >>= 1;
-        if (rotate)
-            b |= (c ? new_c : C) << 7;
+template<Cpu::VREG8 r, bool c, bool rotate, typename T>
+ALWAYS_INLINE inline void Cpu::opSr()
+{
+    T b = readReg<r>();
 
-        Z = b == 0;
-        N = 0;
-        H = 0;
-        C = new_c;
+    bool new_c = b & 1;
 
-        writeReg(r, b);
-    };
+    b >>= 1;
+    if (rotate)
+        b |= (c ? new_c : C) << 7;
 
-    auto op_sl = [this]<typename T>(VREG8 r, bool c, bool rotate) ALWAYS_INLINE
-    {
-        T b = readReg(r);
+    Z = b == 0;
+    N = 0;
+    H = 0;
+    C = new_c;
 
-        bool new_c = b >> 7;
+    writeReg<r>(b);
+}
 
-        b <<= 1;
-        if (rotate)
-            b |= c ? new_c : C;
+template<Cpu::VREG8 r, bool c, bool rotate, typename T>
+ALWAYS_INLINE inline void Cpu::opSl()
+{
+    T b = readReg<r>();
 
-        Z = b == 0;
-        N = 0;
-        H = 0;
-        C = new_c;
+    bool new_c = b >> 7;
 
-        writeReg(r, b);
-    };
+    b <<= 1;
+    if (rotate)
+        b |= c ? new_c : C;
 
-    auto op_swap = [this](VREG8 r) ALWAYS_INLINE
-    {
-        u8 b = readReg(r);
-        b = ((b & 0xF) << 4) | ((b >> 4) & 0xF);
-        Z = b == 0;
-        N = 0;
-        H = 0;
-        C = 0;
-        writeReg(r, b);
-    };
+    Z = b == 0;
+    N = 0;
+    H = 0;
+    C = new_c;
 
-    MAKE_OP1(0x00, 8, op_sl.operator()<u8>, true, true);   // rlc
-    MAKE_OP1(0x08, 8, op_sr.operator()<u8>, true, true);   // rrc
-    MAKE_OP1(0x10, 8, op_sl.operator()<u8>, false, true);  // rl
-    MAKE_OP1(0x18, 8, op_sr.operator()<u8>, false, true);  // rr
-    MAKE_OP1(0x20, 8, op_sl.operator()<u8>, false, false); // sla
-    MAKE_OP1(0x28, 8, op_sr.operator()<s8>, false, false); // sra
-    MAKE_OP1(0x30, 8, op_swap);                            // swap
-    MAKE_OP1(0x38, 8, op_sr.operator()<u8>, false, false); // srl
+    writeReg<r>(b);
+}
 
-    MAKE_OP_IDX(0x40, 0x40, op_bit);
-    MAKE_OP_IDX(0x80, 0x40, op_res);
-    MAKE_OP_IDX(0xC0, 0x40, op_set);
+template<Cpu::VREG8 r>
+ALWAYS_INLINE inline void Cpu::opSwap()
+{
+    u8 b = readReg<r>();
+    b = ((b & 0xF) << 4) | ((b >> 4) & 0xF);
+    Z = b == 0;
+    N = 0;
+    H = 0;
+    C = 0;
+    writeReg<r>(b);
+}
 
-    UNIMPLEMENTED("Unimplemented opcode");
+template<u8 op>
+void Cpu::executeCB()
+{
+    constexpr VREG8 r = OP_REG(op);
+    constexpr size_t idx = (op / 8) % 8;
+
+    if constexpr (IS_OP(op, 0x00, 8))
+        opSl<r, true, true, u8>(); // rlc
+    else if constexpr (IS_OP(op, 0x08, 8))
+        opSr<r, true, true, u8>(); // rrc
+    else if constexpr (IS_OP(op, 0x10, 8))
+        opSl<r, false, true, u8>(); // rl
+    else if constexpr (IS_OP(op, 0x18, 8))
+        opSr<r, false, true, u8>(); // rr
+    else if constexpr (IS_OP(op, 0x20, 8))
+        opSl<r, false, false, u8>(); // sla
+    else if constexpr (IS_OP(op, 0x28, 8))
+        opSr<r, false, false, s8>(); // sra
+    else if constexpr (IS_OP(op, 0x30, 8))
+        opSwap<r>(); // swap
+    else if constexpr (IS_OP(op, 0x38, 8))
+        opSr<r, false, false, u8>(); // srl
+
+    else if constexpr (IS_OP(op, 0x40, 0x40))
+        opBit<r, idx>();
+    else if constexpr (IS_OP(op, 0x80, 0x40))
+        opRes<r, idx>();
+    else
+        opSet<r, idx>();
 }
 
+// handler stubs, generated from tools/Opcodes.json
+#define OP_HANDLER(op, ...) &Cpu::execute<op>,
+#define OP_HANDLER_ILLEGAL(op) &Cpu::execute<op>,
+#define CB_OP_HANDLER(op, ...) &Cpu::executeCB<op>,
+
+const std::array<Cpu::OpHandler, 0x100> Cpu::s_ops = {
+    OPTABLE_UNPREFIXED(OP_HANDLER, OP_HANDLER_ILLEGAL)
+};
+const std::array<Cpu::OpHandler, 0x100> Cpu::s_cb_ops = {
+    OPTABLE_CBPREFIXED(CB_OP_HANDLER)
+};
+
 }
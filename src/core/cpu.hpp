@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include "types.hpp"
 
 namespace gbemu::core
@@ -8,6 +9,9 @@ namespace gbemu::core
 class Memory;
 class Timer;
 class InterruptController;
+class Scheduler;
+class StateReader;
+class StateWriter;
 
 class Cpu
 {
@@ -34,7 +38,8 @@ public:
     };
 
 public:
-    Cpu(Memory* memory, Timer* timer, InterruptController* interrupt);
+    Cpu(Memory* memory, Timer* timer, InterruptController* interrupt,
+        Scheduler* scheduler);
 
     void reset();
     void step();
@@ -51,13 +56,75 @@ public:
     void writeReg(VREG8 reg, u8 data);
 
     void processInt();
+    void tick(size_t clocks) { m_clocks += clocks; }
+    size_t clocks() { return m_clocks; }
     void unhalt() { m_halted = false; }
     bool isHalted() { return m_halted; }
     void setLogging(bool enable) { m_logging_enable = enable; }
 
+    void saveState(StateWriter& state);
+    void loadState(StateReader& state);
+
 private:
-    void execute(u8 op);
-    void executeCB(u8 op);
+    using OpHandler = void (Cpu::*)();
+
+    void syncIo(u16 addr);
+    // whether an instruction charged the cycles listed in OP_INFO
+    bool matchesOpInfo(u16 addr, u8 op, size_t clocks);
+
+    // one specialized handler per opcode, see s_ops/s_cb_ops
+    template<u8 op>
+    void execute();
+    template<u8 op>
+    void executeCB();
+
+    // operands resolved at compile time
+    template<VREG8 reg>
+    u8 readReg();
+    template<VREG8 reg>
+    void writeReg(u8 data);
+
+    void opJr(bool cond, s8 n);
+    void opJp(bool cond, u16 addr);
+    void opRet();
+    void opRet(bool cond);
+    void opCall(bool cond, u16 addr);
+    void opAddHl(u16 a);
+
+    template<VREG8 dst, VREG8 src>
+    void opLd();
+    template<VREG8 dst, VREG8 src, bool c>
+    void opAdd();
+    template<VREG8 dst, VREG8 src, bool c>
+    void opSub();
+    template<VREG8 dst, VREG8 src>
+    void opAnd();
+    template<VREG8 dst, VREG8 src>
+    void opXor();
+    template<VREG8 dst, VREG8 src>
+    void opOr();
+    template<VREG8 dst, VREG8 src>
+    void opCp();
+    template<VREG8 r>
+    void opInc();
+    template<VREG8 r>
+    void opDec();
+
+    template<VREG8 r, size_t idx>
+    void opBit();
+    template<VREG8 r, size_t idx>
+    void opRes();
+    template<VREG8 r, size_t idx>
+    void opSet();
+    template<VREG8 r, bool c, bool rotate, typename T>
+    void opSr();
+    template<VREG8 r, bool c, bool rotate, typename T>
+    void opSl();
+    template<VREG8 r>
+    void opSwap();
+
+    static const std::array<OpHandler, 0x100> s_ops;
+    static const std::array<OpHandler, 0x100> s_cb_ops;
 
 public:
     auto mem() { return m_memory; }
@@ -67,8 +134,10 @@ private:
     Memory* m_memory;
     Timer* m_timer;
     InterruptController* m_interrupt_controller;
+    Scheduler* m_scheduler;
     bool m_logging_enable;
     bool m_halted;
+    size_t m_clocks; // T-states, devices catch up lazily
 
 // TODO: handle endianness
 #define REG_8_16(x, y)                                                         \
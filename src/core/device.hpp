@@ -7,11 +7,18 @@ namespace gbemu::core
 {
 
 class Memory;
+class StateReader;
+class StateWriter;
+
 class Device
 {
 public:
     virtual ~Device() {}
     virtual void mapMemory(Memory* mem) = 0;
+
+    // see save_state.hpp, loading must restore the exact same sequence
+    virtual void saveState(StateWriter& state) = 0;
+    virtual void loadState(StateReader& state) = 0;
 };
 
 }
\ No newline at end of file
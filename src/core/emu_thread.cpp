@@ -0,0 +1,157 @@
+#include "emu_thread.hpp"
+#include <algorithm>
+#include <chrono>
+#include "gameboy.hpp"
+#include "joypad.hpp"
+#include "timer.hpp"
+
+namespace gbemu::core
+{
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr auto FRAME_DURATION = std::chrono::duration<f64>(
+    static_cast<f64>(FRAME_CYCLES) / Timer::SYSTEM_FREQUENCY);
+// frames skipped between two drawn ones when unthrottled
+static constexpr size_t FAST_FORWARD_SKIP = 7;
+// a few minutes of history, rewinding plays it back at 4x
+static constexpr size_t REWIND_CAPACITY = 8 * 1024 * 1024;
+static constexpr size_t REWIND_INTERVAL = 4;
+
+EmuThread::EmuThread(Gameboy* gb) :
+    m_gb(gb),
+    m_rewind(REWIND_CAPACITY, REWIND_INTERVAL),
+    m_rewinding(false),
+    m_quit(false),
+    m_running(true),
+    m_frame_count(0),
+    m_speed(1.0f)
+{
+}
+
+EmuThread::~EmuThread()
+{
+    stop();
+}
+
+void EmuThread::start()
+{
+    if (m_thread.joinable())
+        return;
+
+    m_quit = false;
+    m_thread = std::thread(&EmuThread::run, this);
+}
+
+void EmuThread::stop()
+{
+    if (!m_thread.joinable())
+        return;
+
+    m_quit = true;
+    m_thread.join();
+}
+
+void EmuThread::run()
+{
+    auto deadline = Clock::now();
+
+    while (!m_quit)
+    {
+        processEvents();
+
+        if (!m_running)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            deadline = Clock::now();
+            continue;
+        }
+
+        f32 speed = m_speed;
+
+        RunResult res = RunResult_VBlank;
+        {
+            std::lock_guard lock(m_lock);
+            if (m_rewinding)
+            {
+                // the states hold the frame they were captured on, stays on
+                // the oldest one once the history runs out
+                m_rewind.rewind(m_gb);
+            }
+            else
+            {
+                m_gb->ppu()->setFrameSkip(speed > 0 ? 0 : FAST_FORWARD_SKIP);
+                res = m_gb->runFrame();
+                if (res == RunResult_VBlank)
+                    m_rewind.onFrame(m_gb);
+            }
+        }
+
+        if (res == RunResult_Breakpoint)
+            m_running = false;
+        publishFrame();
+
+        if (speed > 0)
+        {
+            // don't try to catch up after a stall, just resume from now
+            deadline = std::max(
+                deadline + std::chrono::duration_cast<Clock::duration>(
+                               FRAME_DURATION / speed),
+                Clock::now() - std::chrono::milliseconds(100));
+            std::this_thread::sleep_until(deadline);
+        }
+    }
+}
+
+void EmuThread::processEvents()
+{
+    if (m_events.empty())
+        return;
+
+    std::lock_guard lock(m_lock);
+
+    while (auto event = m_events.pop())
+    {
+        switch (event->type)
+        {
+            case EmuEventType_Buttons:
+                m_gb->joypad()->setButtons(event->arg);
+                break;
+            case EmuEventType_Run:
+                m_running = true;
+                break;
+            case EmuEventType_Pause:
+                m_running = false;
+                break;
+            case EmuEventType_Step:
+                if (!m_running)
+                {
+                    m_gb->step();
+                    publishFrame();
+                }
+                break;
+            case EmuEventType_AddBreakpoint:
+                m_gb->setBreakpoint(event->arg, true);
+                break;
+            case EmuEventType_RemoveBreakpoint:
+                m_gb->setBreakpoint(event->arg, false);
+                break;
+            case EmuEventType_Rewind:
+                m_rewinding = event->arg != 0;
+                break;
+        }
+    }
+}
+
+void EmuThread::publishFrame()
+{
+    // skipped frames would only repeat the last picture
+    if (m_gb->ppu()->isFrameRendered())
+    {
+        m_frames.writeBuffer() = m_gb->ppu()->frame();
+        m_frames.publish();
+    }
+    m_frame_count++;
+}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "types.hpp"
+#include "common/spsc_queue.hpp"
+#include "common/triple_buffer.hpp"
+#include "ppu.hpp"
+#include "rewind.hpp"
+
+namespace gbemu::core
+{
+
+class Gameboy;
+
+enum EmuEventType : u8
+{
+    EmuEventType_Buttons,         // JoypadButton mask
+    EmuEventType_Run,
+    EmuEventType_Pause,
+    EmuEventType_Step,            // single instruction, while paused
+    EmuEventType_AddBreakpoint,
+    EmuEventType_RemoveBreakpoint,
+    EmuEventType_Rewind,          // 1 while held, 0 once released
+};
+
+struct EmuEvent
+{
+    EmuEventType type;
+    u16 arg;
+};
+
+// Runs the emulation on its own thread. Completed frames are published to a
+// triple buffer and frontend events are received over a SPSC queue so that
+// neither side blocks the other.
+class EmuThread
+{
+public:
+    EmuThread(Gameboy* gb);
+    ~EmuThread();
+
+    void start();
+    void stop();
+
+    // frontend side
+    bool pushEvent(EmuEvent event) { return m_events.push(event); }
+    // returns true if a new frame was published since the last call
+    bool updateFrame() { return m_frames.update(); }
+    const IndexedFrame& frame() const { return m_frames.readBuffer(); }
+
+    bool isRunning() const { return m_running.load(); }
+    size_t frameCount() const { return m_frame_count.load(); }
+
+    // 1.0 is real-time, 0 runs unthrottled
+    void setSpeed(f32 speed) { m_speed.store(speed); }
+
+    // held while the emulator runs, lock it before touching the Gameboy from
+    // another thread (e.g. debug views)
+    std::mutex& lock() { return m_lock; }
+
+private:
+    void run();
+    void processEvents();
+    void publishFrame();
+
+private:
+    Gameboy* m_gb;
+    std::thread m_thread;
+    std::mutex m_lock;
+    SpscQueue<EmuEvent, 64> m_events;
+    TripleBuffer<IndexedFrame> m_frames;
+    RewindBuffer m_rewind;
+    bool m_rewinding;
+    std::atomic<bool> m_quit;
+    std::atomic<bool> m_running;
+    std::atomic<size_t> m_frame_count;
+    std::atomic<f32> m_speed;
+};
+
+}
@@ -1,4 +1,6 @@
 #include "gameboy.hpp"
+#include <algorithm>
+#include <cstring>
 #include "common/logging.hpp"
 #include "apu.hpp"
 #include "cart.hpp"
@@ -8,12 +10,25 @@
 #include "joypad.hpp"
 #include "memory.hpp"
 #include "ppu.hpp"
+#include "save_state.hpp"
+#include "scheduler.hpp"
 #include "serial.hpp"
 #include "timer.hpp"
 
 namespace gbemu::core
 {
 
+static constexpr u32 STATE_MAGIC = 0x54534247; // "GBST"
+
+struct StateHeader
+{
+    u32 magic;
+    u32 version;
+    u32 size;          // header included
+    u16 cart_checksum; // global checksum from the cartridge header
+    u16 reserved;
+};
+
 Gameboy::Gameboy() :
     m_bootrom(std::vector<u8>(BOOTROM_SIZE)),
     m_bootrom_enabled(true),
@@ -21,14 +36,17 @@ Gameboy::Gameboy() :
     m_wram0(std::vector<u8>(WRAM0_SIZE)),
     m_wram1(std::vector<u8>(WRAM1_SIZE)),
     m_memory(std::make_unique<Memory>()),
+    m_scheduler(std::make_unique<Scheduler>()),
     m_interrupt_controller(std::make_unique<InterruptController>()),
-    m_timer(std::make_unique<Timer>(interrupts())),
-    m_cpu(std::make_unique<Cpu>(mem(), timer(), interrupts())),
-    m_ppu(std::make_unique<Ppu>(interrupts())),
-    m_apu(std::make_unique<Apu>()),
+    m_timer(std::make_unique<Timer>(interrupts(), scheduler())),
+    m_cpu(std::make_unique<Cpu>(mem(), timer(), interrupts(), scheduler())),
+    m_ppu(std::make_unique<Ppu>(interrupts(), scheduler())),
+    m_apu(std::make_unique<Apu>(scheduler())),
     m_joypad(std::make_unique<Joypad>(interrupts())),
-    m_serial(std::make_unique<Serial>(interrupts())),
-    m_gb_type(GameboyType_DMG)
+    m_serial(std::make_unique<Serial>(interrupts(), scheduler())),
+    m_gb_type(GameboyType_DMG),
+    m_key1(0),
+    m_breakpoint_count(0)
 {
     // map bootrom
     mem()->mapRO(BOOTROM_START, m_bootrom.data(), m_bootrom.size());
@@ -41,10 +59,8 @@ Gameboy::Gameboy() :
     mem()->mapRW(WRAM1_START, m_wram1.data(), m_wram1.size());
 
     // map bootrom disable register
-    mem()->mapWO(
-        MmioWrite(BOOT_ADDR, 1,
-                  std::bind(&Gameboy::disableBootRom, this,
-                            std::placeholders::_1, std::placeholders::_2)));
+    mem()->mapWO(MmioWrite(BOOT_ADDR, 1,
+                           MmioWrite::handler<&Gameboy::disableBootRom>(this)));
 
     // map registers
     m_interrupt_controller->mapMemory(mem());
@@ -54,9 +70,11 @@ Gameboy::Gameboy() :
     m_joypad->mapMemory(mem());
     m_serial->mapMemory(mem());
 
+    // the APU frame sequencer follows DIV
+    m_timer->setDivResetHandler(Scheduler::handler<&Apu::onDivReset>(apu()));
+
     // stub register
-    static u8 stub = 0;
-    mem()->mapRO(KEY1_ADDR, &stub);
+    mem()->mapRO(KEY1_ADDR, &m_key1);
 }
 
 Gameboy::~Gameboy()
@@ -68,16 +86,32 @@ Result<void> Gameboy::disableBootRom(u16 off, u8 data)
     if (data == 0)
         return {};
 
-    if (m_bootrom_enabled)
+    mapBootrom(false);
+    return {};
+}
+
+void Gameboy::mapBootrom(bool enabled)
+{
+    if (enabled == m_bootrom_enabled)
+        return;
+
+    if (enabled)
+    {
+        // unmap cartridge bank 0
+        mem()->unmapRO(ROM0_START);
+        mem()->mapRO(BOOTROM_START, m_bootrom.data(), m_bootrom.size());
+    }
+    else
     {
         // unmap bootrom
         mem()->unmapRO(BOOTROM_START);
         mem()->unmapRO(BOOTROM_END);
-        // map entire cartridge bank 0
-        cart()->mapMemory(mem(), false);
     }
-    m_bootrom_enabled = false;
-    return {};
+    m_bootrom_enabled = enabled;
+
+    // map the part of bank 0 not covered by the bootrom
+    if (m_cart)
+        cart()->mapMemory(mem(), enabled);
 }
 
 Result<void> Gameboy::setBootrom(std::vector<u8> bootrom)
@@ -102,17 +136,65 @@ Result<void> Gameboy::setCartridge(std::unique_ptr<Cart> cart)
 
 void Gameboy::step()
 {
-    size_t old_clocks = timer()->systemClocks();
-
     interrupts()->processInterrupts(cpu());
     cpu()->step();
 
-    size_t new_clocks = timer()->systemClocks();
-    size_t clocks_diff = new_clocks - old_clocks;
+    // devices only run when one of their events is due
+    size_t clocks = cpu()->clocks();
+    if (clocks >= scheduler()->nextEvent())
+        scheduler()->sync(clocks);
+}
+
+template<bool stop_at_vblank>
+RunResult Gameboy::run(size_t clocks)
+{
+    size_t end = cpu()->clocks() + clocks;
+    size_t frame = ppu()->frameCount();
+
+    // the instruction at the current PC always runs, so that execution can
+    // resume from a breakpoint
+    for (bool first = true;; first = false)
+    {
+        // checked after dispatch so that breakpoints on vectors are hit
+        interrupts()->processInterrupts(cpu());
+        if (!first && m_breakpoint_count != 0 &&
+            m_breakpoints[cpu()->regs().pc])
+            return RunResult_Breakpoint;
+
+        cpu()->step();
 
-    joypad()->processInput();
-    ppu()->step(mem(), timer()->systemClocks());
-    apu()->step(clocks_diff);
+        size_t now = cpu()->clocks();
+        if (now >= scheduler()->nextEvent())
+            scheduler()->sync(now);
+
+        if (stop_at_vblank && ppu()->frameCount() != frame)
+            return RunResult_VBlank;
+        if (now >= end)
+            return RunResult_Budget;
+    }
+}
+
+RunResult Gameboy::runCycles(size_t clocks)
+{
+    return run<false>(clocks);
+}
+
+RunResult Gameboy::runFrame()
+{
+    // a VBlank always happens within a frame worth of cycles
+    return run<true>(FRAME_CYCLES);
+}
+
+void Gameboy::setBreakpoint(u16 addr, bool enable)
+{
+    if (m_breakpoints[addr] == enable)
+        return;
+
+    m_breakpoints[addr] = enable;
+    if (enable)
+        m_breakpoint_count++;
+    else
+        m_breakpoint_count--;
 }
 
 Result<void> Gameboy::powerOn()
@@ -121,4 +203,123 @@ Result<void> Gameboy::powerOn()
     return {};
 }
 
+u16 Gameboy::cartChecksum()
+{
+    if (!m_cart)
+        return 0;
+
+    auto checksum = cart()->header()->global_checksum;
+    return checksum[0] << 8 | checksum[1];
+}
+
+void Gameboy::writeState(StateWriter& state)
+{
+    state.write(m_bootrom_enabled);
+    state.write(m_hram.data(), m_hram.size());
+    state.write(m_wram0.data(), m_wram0.size());
+    state.write(m_wram1.data(), m_wram1.size());
+
+    m_scheduler->saveState(state);
+    m_interrupt_controller->saveState(state);
+    m_timer->saveState(state);
+    m_cpu->saveState(state);
+    m_ppu->saveState(state);
+    m_apu->saveState(state);
+    m_joypad->saveState(state);
+    m_serial->saveState(state);
+    if (m_cart)
+        m_cart->saveState(state);
+}
+
+void Gameboy::readState(StateReader& state)
+{
+    bool bootrom_enabled = m_bootrom_enabled;
+    state.read(bootrom_enabled);
+    mapBootrom(bootrom_enabled);
+    state.read(m_hram.data(), m_hram.size());
+    state.read(m_wram0.data(), m_wram0.size());
+    state.read(m_wram1.data(), m_wram1.size());
+
+    m_scheduler->loadState(state);
+    m_interrupt_controller->loadState(state);
+    m_timer->loadState(state);
+    m_cpu->loadState(state);
+    m_ppu->loadState(state);
+    m_apu->loadState(state);
+    m_joypad->loadState(state);
+    m_serial->loadState(state);
+    if (m_cart)
+        m_cart->loadState(state);
+}
+
+size_t Gameboy::stateSize()
+{
+    // only counts
+    StateWriter state;
+    writeState(state);
+    return sizeof(StateHeader) + state.size();
+}
+
+Result<size_t> Gameboy::saveState(std::span<u8> buffer)
+{
+    ERROR_IF(buffer.size() < sizeof(StateHeader), StateError_BufferTooSmall);
+
+    StateWriter state(buffer.subspan(sizeof(StateHeader)));
+    writeState(state);
+    ERROR_IF(state.overflowed(), StateError_BufferTooSmall);
+
+    StateHeader header;
+    header.magic = STATE_MAGIC;
+    header.version = SAVE_STATE_VERSION;
+    header.size = sizeof(StateHeader) + state.size();
+    header.cart_checksum = cartChecksum();
+    header.reserved = 0;
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    return header.size;
+}
+
+Result<void> Gameboy::loadState(std::span<const u8> buffer)
+{
+    StateHeader header;
+    ERROR_IF(buffer.size() < sizeof(header), StateError_InvalidHeader);
+    std::memcpy(&header, buffer.data(), sizeof(header));
+
+    ERROR_IF(header.magic != STATE_MAGIC, StateError_InvalidHeader);
+    ERROR_IF(header.version != SAVE_STATE_VERSION,
+             StateError_UnsupportedVersion);
+    ERROR_IF(header.cart_checksum != cartChecksum(), StateError_CartMismatch);
+    // the devices trust the layout, nothing is touched unless it is complete
+    ERROR_IF(header.size != buffer.size() || header.size != stateSize(),
+             StateError_InvalidHeader);
+
+    StateReader state(buffer.subspan(sizeof(header)));
+    readState(state);
+
+    return {};
+}
+
+Result<std::unique_ptr<Gameboy>> Gameboy::fork()
+{
+    auto gb = std::make_unique<Gameboy>();
+
+    // already mapped, only the contents change
+    std::copy(m_bootrom.begin(), m_bootrom.end(), gb->m_bootrom.begin());
+    gb->m_gb_type = m_gb_type;
+    if (m_cart)
+    {
+        auto ret = gb->setCartridge(m_cart->fork());
+        if (!ret)
+            return tl::make_unexpected(ret.error());
+    }
+
+    std::vector<u8> state(stateSize());
+    PROPAGATE_ERROR(saveState(state));
+    auto ret = gb->loadState(state);
+    if (!ret)
+        return tl::make_unexpected(ret.error());
+
+    return gb;
+}
+
 }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <bits/unique_ptr.h>
+#include <bitset>
+#include <span>
 #include <vector>
 #include "types.hpp"
 #include "result.hpp"
@@ -15,8 +17,18 @@ class InterruptController;
 class Joypad;
 class Memory;
 class Ppu;
+class Scheduler;
 class Timer;
 class Serial;
+class StateReader;
+class StateWriter;
+
+enum RunResult
+{
+    RunResult_Budget,     // cycle budget exhausted
+    RunResult_VBlank,     // a frame was completed
+    RunResult_Breakpoint, // stopped before a breakpoint
+};
 
 enum GameboyType
 {
@@ -36,13 +48,37 @@ public:
     Result<void> powerOn();
     void step();
 
+    // Execute until the budget (T-states) runs out or a breakpoint is hit.
+    // A breakpoint on the current PC does not stop the first instruction.
+    RunResult runCycles(size_t clocks);
+    // Same as runCycles() but also stops at the next VBlank.
+    RunResult runFrame();
+
+    void setBreakpoint(u16 addr, bool enable);
+    bool hasBreakpoint(u16 addr) const { return m_breakpoints[addr]; }
+
     Result<void> disableBootRom(u16 off, u8 data);
 
+    // Save states are tied to the cartridge and SAVE_STATE_VERSION. Their
+    // size never changes for a given cartridge, so a single buffer of
+    // stateSize() bytes can be allocated once and reused. Only call between
+    // two instructions.
+    size_t stateSize();
+    // returns the number of bytes written
+    Result<size_t> saveState(std::span<u8> buffer);
+    Result<void> loadState(std::span<const u8> buffer);
+
+    // Independent copy of the current state. The cartridge ROM is shared,
+    // the rest is small enough to be copied through a save state. The
+    // breakpoints and the audio sink are not copied.
+    Result<std::unique_ptr<Gameboy>> fork();
+
 public:
     Cpu* cpu() { return m_cpu.get(); }
     Ppu* ppu() { return m_ppu.get(); }
     Timer* timer() { return m_timer.get(); }
     Memory* mem() { return m_memory.get(); }
+    Scheduler* scheduler() { return m_scheduler.get(); }
     Apu* apu() { return m_apu.get(); }
     InterruptController* interrupts() { return m_interrupt_controller.get(); }
     Joypad* joypad() { return m_joypad.get(); }
@@ -50,6 +86,17 @@ public:
     GameboyType gbType() { return m_gb_type; }
     bool isGb(GameboyType type) { return m_gb_type == type; }
 
+private:
+    template<bool stop_at_vblank>
+    RunResult run(size_t clocks);
+
+    // the bootrom overlays the start of the cartridge
+    void mapBootrom(bool enabled);
+    u16 cartChecksum();
+    // everything but the header
+    void writeState(StateWriter& state);
+    void readState(StateReader& state);
+
 private:
     std::vector<u8> m_bootrom;
     bool m_bootrom_enabled;
@@ -57,6 +104,7 @@ private:
     std::vector<u8> m_wram0;
     std::vector<u8> m_wram1; // switchable in cgb mode
     std::unique_ptr<Memory> m_memory;
+    std::unique_ptr<Scheduler> m_scheduler;
     std::unique_ptr<InterruptController> m_interrupt_controller;
     std::unique_ptr<Timer> m_timer;
     std::unique_ptr<Cpu> m_cpu;
@@ -65,7 +113,10 @@ private:
     std::unique_ptr<Joypad> m_joypad;
     std::unique_ptr<Serial> m_serial;
     GameboyType m_gb_type;
+    u8 m_key1; // CGB speed switch, stubbed
     std::unique_ptr<Cart> m_cart;
+    std::bitset<0x10000> m_breakpoints;
+    size_t m_breakpoint_count;
 };
 
 }
@@ -3,6 +3,7 @@
 #include "cpu.hpp"
 #include "io.hpp"
 #include "memory.hpp"
+#include "save_state.hpp"
 
 namespace gbemu::core
 {
@@ -24,6 +25,20 @@ void InterruptController::mapMemory(Memory* mem)
     mem->mapRW(IF_ADDR, &m_if);
 }
 
+void InterruptController::saveState(StateWriter& state)
+{
+    state.write(m_ime);
+    state.write(m_if);
+    state.write(m_ie);
+}
+
+void InterruptController::loadState(StateReader& state)
+{
+    state.read(m_ime);
+    state.read(m_if);
+    state.read(m_ie);
+}
+
 void InterruptController::requestInterrupt(InterruptType type)
 {
     m_if.raw |= 1 << type;
@@ -25,6 +25,8 @@ public:
     InterruptController();
 
     virtual void mapMemory(Memory* mem) override;
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
 
     void requestInterrupt(InterruptType type);
     void processInterrupts(Cpu* cpu);
@@ -1,19 +1,60 @@
 #include "joypad.hpp"
+#include "int_controller.hpp"
 #include "io.hpp"
 #include "memory.hpp"
+#include "save_state.hpp"
 
 namespace gbemu::core
 {
 
 Joypad::Joypad(InterruptController* interrupts) :
     m_p1({ 0 }),
+    m_buttons(0),
     m_interrupts(interrupts)
 {
 }
 
 void Joypad::mapMemory(Memory* mem)
 {
-    mem->mapRW(P1_ADDR, &m_p1, 1, 0b00110000);
+    mem->mapRW(MmioRead(P1_ADDR, 1, MmioRead::handler<&Joypad::readP1>(this)),
+               MmioWrite(P1_ADDR, 1, &m_p1, 0b00110000));
+}
+
+void Joypad::saveState(StateWriter& state)
+{
+    state.write(m_p1);
+    state.write(m_buttons);
+}
+
+void Joypad::loadState(StateReader& state)
+{
+    state.read(m_p1);
+    state.read(m_buttons);
+}
+
+// pressed buttons of the selected groups, active high
+u8 Joypad::selectedLines()
+{
+    u8 lines = 0;
+    if (m_p1.select_direction == 0)
+        lines |= m_buttons & 0xF;
+    if (m_p1.select_button == 0)
+        lines |= m_buttons >> 4;
+    return lines;
+}
+
+void Joypad::setButtons(u8 buttons)
+{
+    u8 old_lines = selectedLines();
+    m_buttons = buttons;
+
+    if (~old_lines & selectedLines())
+        m_interrupts->requestInterrupt(InterruptType_Joypad);
+}
+
+Result<u8> Joypad::readP1(u16 off)
+{
+    return 0xC0 | (m_p1.raw & 0x30) | (~selectedLines() & 0xF);
 }
 
 }
@@ -1,19 +1,40 @@
 #pragma once
 
 #include "device.hpp"
+#include "result.hpp"
 
 namespace gbemu::core
 {
 
 class InterruptController;
 
+enum JoypadButton : u8
+{
+    JoypadButton_Right = 1 << 0,
+    JoypadButton_Left = 1 << 1,
+    JoypadButton_Up = 1 << 2,
+    JoypadButton_Down = 1 << 3,
+    JoypadButton_A = 1 << 4,
+    JoypadButton_B = 1 << 5,
+    JoypadButton_Select = 1 << 6,
+    JoypadButton_Start = 1 << 7,
+};
+
 class Joypad : public Device
 {
 public:
     Joypad(InterruptController* interrupts);
 
     virtual void mapMemory(Memory* mem) override;
-    void processInput();
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
+
+    // JoypadButton mask of the buttons currently held
+    void setButtons(u8 buttons);
+    Result<u8> readP1(u16 off);
+
+private:
+    u8 selectedLines();
 
 private:
     union
@@ -30,6 +51,7 @@ private:
         };
     } PACKED m_p1;
 
+    u8 m_buttons;
     InterruptController* m_interrupts;
 };
 
@@ -3,41 +3,69 @@
 #include "common/logging.hpp"
 #include "core/io.hpp"
 #include "core/memory.hpp"
+#include "core/save_state.hpp"
 
 namespace gbemu::core
 {
 
-Mbc1::Mbc1(std::vector<u8>& rom) : Mbc(rom), m_extram()
+Mbc1::Mbc1(std::span<const u8> rom, bool persistent) :
+    Mbc(rom, persistent),
+    m_extram(header()->ramSize())
 {
     size_t ram_size = header()->ramSize();
 
     // Load save from file if it exists and has the correct size
-    auto save = File::readAllBytes(header()->title);
-    if (save && save.value().size() == ram_size)
-        m_extram = save.value();
-    else
-        m_extram.resize(header()->ramSize());
+    if (m_persistent)
+    {
+        auto save = File::readAllBytes(header()->title);
+        if (save && save.value().size() == ram_size)
+            m_extram = save.value();
+    }
 
     m_mode = 0;
     m_ram_bank = 0;
     m_rom_bank = 1;
+    m_ram_enabled = false;
 }
 
 void Mbc1::map(Memory* mem)
 {
-    mem->mapWO(
-        MmioWrite(0x0000, 0x2000, writeFunc<Mbc1>(&Mbc1::writeRamEnable, mem)));
+    m_mem = mem;
+
+    mem->mapWO(MmioWrite(0x0000, 0x2000,
+                         writeFunc<&Mbc1::writeRamEnable, Mbc1>()));
     mem->mapWO(MmioWrite(0x2000, 0x2000,
-                         writeFunc<Mbc1>(&Mbc1::writeRomBankNumber, mem)));
+                         writeFunc<&Mbc1::writeRomBankNumber, Mbc1>()));
     mem->mapWO(MmioWrite(0x4000, 0x2000,
-                         writeFunc<Mbc1>(&Mbc1::writeRamBankNumber, mem)));
+                         writeFunc<&Mbc1::writeRamBankNumber, Mbc1>()));
     mem->mapWO(MmioWrite(0x6000, 0x2000,
-                         writeFunc<Mbc1>(&Mbc1::writeSelectMode, mem)));
+                         writeFunc<&Mbc1::writeSelectMode, Mbc1>()));
 
     remapBank1(mem);
     remapRAM(mem);
 }
 
+void Mbc1::saveState(StateWriter& state)
+{
+    state.write(m_extram.data(), m_extram.size());
+    state.write(m_rom_bank);
+    state.write(m_ram_bank);
+    state.write(m_mode);
+    state.write(m_ram_enabled);
+}
+
+void Mbc1::loadState(StateReader& state)
+{
+    state.read(m_extram.data(), m_extram.size());
+    state.read(m_rom_bank);
+    state.read(m_ram_bank);
+    state.read(m_mode);
+    state.read(m_ram_enabled);
+
+    remapBank1(m_mem);
+    remapRAM(m_mem);
+}
+
 Result<void> Mbc1::writeRamEnable(Memory* mem, u16 off, u8 data)
 {
     // 4 bits
@@ -45,7 +73,9 @@ Result<void> Mbc1::writeRamEnable(Memory* mem, u16 off, u8 data)
 
     bool enabled = data == 10;
 
-    File::writeAllBytes(header()->title, m_extram.data(), m_extram.size());
+    if (m_persistent)
+        File::writeAllBytes(header()->title, m_extram.data(),
+                            m_extram.size());
 
     if (enabled != m_ram_enabled)
     {
@@ -109,8 +139,7 @@ void Mbc1::remapBank1(Memory* mem)
 {
     // LOG("MBC1 ROM BANK 1 -> {}\n", m_rom_bank);
 
-    auto bank = m_rom.data() + ROM_BANK_SIZE * m_rom_bank;
-    mem->remapRO(ROM1_START, bank, ROM_BANK_SIZE);
+    mem->remapRO(ROM1_START, romBank(m_rom_bank), ROM_BANK_SIZE);
 }
 
 void Mbc1::remapRAM(Memory* mem)
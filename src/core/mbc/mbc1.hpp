@@ -6,9 +6,11 @@ namespace gbemu::core
 class Mbc1 : public Mbc
 {
 public:
-    Mbc1(std::vector<u8>& rom);
+    Mbc1(std::span<const u8> rom, bool persistent);
 
     virtual void map(Memory* mem) override;
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
 
     Result<void> writeRamEnable(Memory* mem, u16 off, u8 data);
     Result<void> writeRomBankNumber(Memory* mem, u16 off, u8 data);
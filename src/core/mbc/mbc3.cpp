@@ -3,20 +3,24 @@
 #include "common/logging.hpp"
 #include "core/io.hpp"
 #include "core/memory.hpp"
+#include "core/save_state.hpp"
 
 namespace gbemu::core
 {
 
-Mbc3::Mbc3(std::vector<u8>& rom) : Mbc(rom), m_extram()
+Mbc3::Mbc3(std::span<const u8> rom, bool persistent) :
+    Mbc(rom, persistent),
+    m_extram(header()->ramSize())
 {
     size_t ram_size = header()->ramSize();
 
     // Load save from file if it exists and has the correct size
-    auto save = File::readAllBytes(header()->title);
-    if (save && save.value().size() == ram_size)
-        m_extram = save.value();
-    else
-        m_extram.resize(header()->ramSize());
+    if (m_persistent)
+    {
+        auto save = File::readAllBytes(header()->title);
+        if (save && save.value().size() == ram_size)
+            m_extram = save.value();
+    }
 
     m_ram_and_timer_enabled = false;
     m_rom_bank = 1;
@@ -32,19 +36,54 @@ Mbc3::Mbc3(std::vector<u8>& rom) : Mbc(rom), m_extram()
 
 void Mbc3::map(Memory* mem)
 {
+    m_mem = mem;
+
     mem->mapWO(MmioWrite(0x0000, 0x2000,
-                         writeFunc<Mbc3>(&Mbc3::writeRamTimerEnable, mem)));
+                         writeFunc<&Mbc3::writeRamTimerEnable, Mbc3>()));
     mem->mapWO(
-        MmioWrite(0x2000, 0x2000, writeFunc<Mbc3>(&Mbc3::writeRomBank, mem)));
+        MmioWrite(0x2000, 0x2000, writeFunc<&Mbc3::writeRomBank, Mbc3>()));
     mem->mapWO(MmioWrite(0x4000, 0x2000,
-                         writeFunc<Mbc3>(&Mbc3::writeRamRtcBank, mem)));
-    mem->mapWO(
-        MmioWrite(0x6000, 0x2000, writeFunc<Mbc3>(&Mbc3::writeLatchData, mem)));
+                         writeFunc<&Mbc3::writeRamRtcBank, Mbc3>()));
+    mem->mapWO(MmioWrite(0x6000, 0x2000,
+                         writeFunc<&Mbc3::writeLatchData, Mbc3>()));
 
     remapRomBank1(mem);
     remapRamRtc(mem);
 }
 
+void Mbc3::saveState(StateWriter& state)
+{
+    state.write(m_extram.data(), m_extram.size());
+    state.write(m_ram_and_timer_enabled);
+    state.write(m_rom_bank);
+    state.write(m_ram_rtc_bank);
+    state.write(m_rtc_latched);
+    state.write(m_latch_data);
+    state.write(m_rts_s);
+    state.write(m_rts_m);
+    state.write(m_rts_h);
+    state.write(m_rts_dl);
+    state.write(m_rts_dh);
+}
+
+void Mbc3::loadState(StateReader& state)
+{
+    state.read(m_extram.data(), m_extram.size());
+    state.read(m_ram_and_timer_enabled);
+    state.read(m_rom_bank);
+    state.read(m_ram_rtc_bank);
+    state.read(m_rtc_latched);
+    state.read(m_latch_data);
+    state.read(m_rts_s);
+    state.read(m_rts_m);
+    state.read(m_rts_h);
+    state.read(m_rts_dl);
+    state.read(m_rts_dh);
+
+    remapRomBank1(m_mem);
+    remapRamRtc(m_mem);
+}
+
 Result<void> Mbc3::writeRamTimerEnable(Memory* mem, u16 off, u8 data)
 {
     // 4 bits
@@ -52,7 +91,9 @@ Result<void> Mbc3::writeRamTimerEnable(Memory* mem, u16 off, u8 data)
 
     bool enabled = data == 10;
 
-    File::writeAllBytes(header()->title, m_extram.data(), m_extram.size());
+    if (m_persistent)
+        File::writeAllBytes(header()->title, m_extram.data(),
+                            m_extram.size());
 
     if (enabled != m_ram_and_timer_enabled)
     {
@@ -138,8 +179,7 @@ Result<u8> Mbc3::readRtc(Memory* mem, u16 off)
 
 void Mbc3::remapRomBank1(Memory* mem)
 {
-    mem->remapRO(ROM1_START, m_rom.data() + m_rom_bank * ROM_BANK_SIZE,
-                 ROM_BANK_SIZE);
+    mem->remapRO(ROM1_START, romBank(m_rom_bank), ROM_BANK_SIZE);
 }
 
 void Mbc3::remapRamRtc(Memory* mem)
@@ -151,8 +191,8 @@ void Mbc3::remapRamRtc(Memory* mem)
                          m_extram.data() + m_ram_rtc_bank * RAM_BANK_SIZE,
                          RAM_BANK_SIZE);
         else
-            mem->remapRW(EXTRAM_START, readFunc<Mbc3>(&Mbc3::readRtc, mem),
-                         writeFunc<Mbc3>(&Mbc3::writeRtc, mem));
+            mem->remapRW(EXTRAM_START, readFunc<&Mbc3::readRtc, Mbc3>(),
+                         writeFunc<&Mbc3::writeRtc, Mbc3>());
     }
     else
     {
@@ -6,9 +6,11 @@ namespace gbemu::core
 class Mbc3 : public Mbc
 {
 public:
-    Mbc3(std::vector<u8>& rom);
+    Mbc3(std::span<const u8> rom, bool persistent);
 
     virtual void map(Memory* mem) override;
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
 
     Result<void> writeRamTimerEnable(Memory* mem, u16 off, u8 data);
     Result<void> writeRomBank(Memory* mem, u16 off, u8 data);
@@ -5,7 +5,7 @@
 namespace gbemu::core
 {
 
-Rom::Rom(std::vector<u8>& rom) : Mbc(rom)
+Rom::Rom(std::span<const u8> rom, bool persistent) : Mbc(rom, persistent)
 {
 }
 
@@ -6,7 +6,7 @@ namespace gbemu::core
 class Rom : public Mbc
 {
 public:
-    Rom(std::vector<u8>& rom);
+    Rom(std::span<const u8> rom, bool persistent);
 
     virtual void map(Memory* mem) override;
 };
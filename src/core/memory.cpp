@@ -28,6 +28,40 @@ Result<Mmio*> Memory::Mapper::findEntry(u16 addr)
     return tl::make_unexpected(MemoryError_CannotFindMapped);
 }
 
+void Memory::Mapper::updatePages(u16 addr, size_t size)
+{
+    size_t first = addr / PAGE_SIZE;
+    size_t last = (addr + size - 1) / PAGE_SIZE;
+
+    for (size_t i = first; i <= last && i < PAGE_COUNT; i++)
+    {
+        u16 page_addr = i * PAGE_SIZE;
+        auto entry = findEntry(page_addr);
+
+        // only pages entirely backed by a single buffer can be direct
+        if (entry && entry.value()->isDirect() &&
+            entry.value()->matches(page_addr, PAGE_SIZE))
+            m_pages[i] = entry.value()->m_buff +
+                         (page_addr - entry.value()->start());
+        else
+            m_pages[i] = nullptr;
+    }
+
+    // refresh the IO slots overlapped by the region
+    if (last >= IO_PAGE)
+    {
+        size_t first_slot = first == IO_PAGE ? addr % PAGE_SIZE : 0;
+        size_t end = std::min<size_t>(addr + size - 1, 0xFFFF);
+        size_t last_slot = end % PAGE_SIZE;
+
+        for (size_t i = first_slot; i <= last_slot; i++)
+        {
+            auto entry = findEntry(IO_PAGE * PAGE_SIZE + i);
+            m_io_slots[i] = entry ? entry.value() : nullptr;
+        }
+    }
+}
+
 Result<void> Memory::Mapper::map(const Mmio& entry)
 {
     ERROR_IF(isRegionMapped(entry.start(), entry.size()),
@@ -36,6 +70,7 @@ Result<void> Memory::Mapper::map(const Mmio& entry)
     if (entry.size() == 1)
     {
         m_fast_entries[entry.start()] = entry;
+        updatePages(entry.start(), entry.size());
         return {};
     }
 
@@ -45,6 +80,7 @@ Result<void> Memory::Mapper::map(const Mmio& entry)
         ++it;
 
     m_entries.insert(it, entry);
+    updatePages(entry.start(), entry.size());
 
     return {};
 }
@@ -54,6 +90,7 @@ Result<void> Memory::Mapper::unmap(u16 addr)
     if (m_fast_entries.contains(addr))
     {
         m_fast_entries.erase(addr);
+        updatePages(addr, 1);
         return {};
     }
 
@@ -61,7 +98,9 @@ Result<void> Memory::Mapper::unmap(u16 addr)
                                    { return buf.start() == addr; });
     if (it != m_entries.end())
     {
+        size_t size = it->size();
         m_entries.erase(it);
+        updatePages(addr, size);
         return {};
     }
 
@@ -88,20 +127,38 @@ Result<void> Memory::Mapper::remap(const Mmio& entry)
     return map(entry);
 }
 
-Result<u8> Memory::read8(u16 addr)
+Result<u8> Memory::readSlow(u16 addr)
 {
+    if (addr / PAGE_SIZE == IO_PAGE)
+    {
+        const Mmio* entry = m_read_map.m_io_slots[addr % PAGE_SIZE];
+        if (entry)
+            return entry->read(addr - entry->start());
+
+        return tl::make_unexpected(MemoryError_ReadUnmappedMemory);
+    }
+
     auto entry = m_read_map.findEntry(addr);
     if (entry)
-        return entry.value()->m_read(addr - entry.value()->start());
+        return entry.value()->read(addr - entry.value()->start());
 
     return tl::make_unexpected(MemoryError_ReadUnmappedMemory);
 }
 
-Result<void> Memory::write8(u16 addr, u8 data)
+Result<void> Memory::writeSlow(u16 addr, u8 data)
 {
+    if (addr / PAGE_SIZE == IO_PAGE)
+    {
+        const Mmio* entry = m_write_map.m_io_slots[addr % PAGE_SIZE];
+        if (entry)
+            return entry->write(addr - entry->start(), data);
+
+        return tl::make_unexpected(MemoryError_WriteUnmappedMemory);
+    }
+
     auto entry = m_write_map.findEntry(addr);
     if (entry)
-        return entry.value()->m_write(addr - entry.value()->start(), data);
+        return entry.value()->write(addr - entry.value()->start(), data);
 
     return tl::make_unexpected(MemoryError_WriteUnmappedMemory);
 }
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <functional>
+#include <list>
+#include <memory>
 #include <unordered_map>
 #include "macro.hpp"
 #include "types.hpp"
@@ -8,30 +12,51 @@
 namespace gbemu::core
 {
 
+// Generic callbacks, kept for compatibility. Prefer the handlers below.
 using MmioReadFunc = std::function<Result<u8>(u16)>;
 using MmioWriteFunc = std::function<Result<void>(u16, u8)>;
 
+// Compact handlers: a plain function pointer called with a context pointer.
+struct MmioReadHandler
+{
+    Result<u8> (*func)(void* ctx, u16 off);
+    void* ctx;
+};
+
+struct MmioWriteHandler
+{
+    Result<void> (*func)(void* ctx, u16 off, u8 value);
+    void* ctx;
+};
+
 struct Mmio
 {
 public:
-    Mmio(u16 addr, size_t size, MmioReadFunc read) :
+    Mmio(u16 addr, size_t size, MmioReadHandler read) :
         m_address(addr),
         m_size(size),
         m_is_read(true),
-        m_read(read),
-        m_write(nullptr)
+        m_read(read)
     {
     }
 
-    Mmio(u16 addr, size_t size, MmioWriteFunc write) :
+    Mmio(u16 addr, size_t size, MmioWriteHandler write) :
         m_address(addr),
         m_size(size),
         m_is_read(false),
-        m_read(nullptr),
         m_write(write)
     {
     }
 
+    Mmio(u16 addr, size_t size, bool is_read, u8* buff, u8 mask) :
+        m_address(addr),
+        m_size(size),
+        m_is_read(is_read),
+        m_buff(buff),
+        m_mask(mask)
+    {
+    }
+
     Mmio() {}
 
     constexpr bool intersect(u16 addr, size_t size)
@@ -48,13 +73,37 @@ public:
     constexpr u16 size() const { return m_size; }
     constexpr bool isRead() const { return m_is_read; }
     constexpr bool isWrite() const { return !m_is_read; }
+    // plain buffers without mask can be accessed directly through the page
+    // table
+    constexpr bool isDirect() const { return m_buff && m_mask == 0xFF; }
+
+    Result<u8> read(u16 off) const
+    {
+        if (m_buff)
+            return m_buff[off] & m_mask;
+        return m_read.func(m_read.ctx, off);
+    }
+    Result<void> write(u16 off, u8 value) const
+    {
+        if (m_buff)
+        {
+            m_buff[off] = (m_buff[off] & ~m_mask) | (value & m_mask);
+            return {};
+        }
+        return m_write.func(m_write.ctx, off, value);
+    }
 
     u16 m_address;
     u16 m_size;
     bool m_is_read;
+    // backing buffer if this entry maps plain memory
+    u8* m_buff = nullptr;
+    u8 m_mask = 0xFF;
     // don't make a union to make it a POD type
-    MmioReadFunc m_read;
-    MmioWriteFunc m_write;
+    MmioReadHandler m_read = {};
+    MmioWriteHandler m_write = {};
+    // owns the std::function wrapped by the handlers above, if any
+    std::shared_ptr<void> m_func;
 };
 
 // Wrappers around Mmio
@@ -76,11 +125,33 @@ public:
         return std::bind(readBuffImpl, buff, mask, std::placeholders::_1);
     }
 
-    MmioRead(u16 addr, size_t size, MmioReadFunc read) : Mmio(addr, size, read)
+    // Handler calling T::Func(off) on obj
+    template<auto Func, typename T>
+    static MmioReadHandler handler(T* obj)
     {
+        return { [](void* ctx, u16 off) -> Result<u8>
+                 { return (static_cast<T*>(ctx)->*Func)(off); },
+                 obj };
+    }
+
+    MmioRead(u16 addr, size_t size, MmioReadHandler read) :
+        Mmio(addr, size, read)
+    {
+    }
+    MmioRead(u16 addr, size_t size, MmioReadFunc read) :
+        Mmio(addr, size,
+             MmioReadHandler{
+                 [](void* ctx, u16 off)
+                 { return (*static_cast<MmioReadFunc*>(ctx))(off); },
+                 nullptr })
+    {
+        auto func = std::make_shared<MmioReadFunc>(std::move(read));
+        m_read.ctx = func.get();
+        m_func = std::move(func);
     }
     MmioRead(u16 addr, size_t size, const void* buff, u8 mask = 0xFF) :
-        Mmio(addr, size, readFunc(buff, mask))
+        Mmio(addr, size, true, reinterpret_cast<u8*>(const_cast<void*>(buff)),
+             mask)
     {
     }
 };
@@ -107,18 +178,43 @@ public:
                          std::placeholders::_2);
     }
 
-    MmioWrite(u16 addr, size_t size, MmioWriteFunc write) :
+    // Handler calling T::Func(off, value) on obj
+    template<auto Func, typename T>
+    static MmioWriteHandler handler(T* obj)
+    {
+        return { [](void* ctx, u16 off, u8 value) -> Result<void>
+                 { return (static_cast<T*>(ctx)->*Func)(off, value); },
+                 obj };
+    }
+
+    MmioWrite(u16 addr, size_t size, MmioWriteHandler write) :
         Mmio(addr, size, write)
     {
     }
+    MmioWrite(u16 addr, size_t size, MmioWriteFunc write) :
+        Mmio(addr, size,
+             MmioWriteHandler{
+                 [](void* ctx, u16 off, u8 value)
+                 { return (*static_cast<MmioWriteFunc*>(ctx))(off, value); },
+                 nullptr })
+    {
+        auto func = std::make_shared<MmioWriteFunc>(std::move(write));
+        m_write.ctx = func.get();
+        m_func = std::move(func);
+    }
     MmioWrite(u16 addr, size_t size, void* buff, u8 mask = 0xFF) :
-        Mmio(addr, size, writeFunc(buff, mask))
+        Mmio(addr, size, false, reinterpret_cast<u8*>(buff), mask)
     {
     }
 };
 
 class Memory
 {
+public:
+    static constexpr size_t PAGE_SIZE = 0x100;
+    static constexpr size_t PAGE_COUNT = 0x10000 / PAGE_SIZE;
+    static constexpr size_t IO_PAGE = 0xFF; // 0xFF00-0xFFFF
+
 private:
     struct Mapper
     {
@@ -127,9 +223,16 @@ private:
         Result<void> remap(const Mmio& entry);
         Result<Mmio*> findEntry(u16 addr);
         bool isRegionMapped(u16 addr, u16 size);
+        void updatePages(u16 addr, size_t size);
 
-        std::vector<Mmio> m_entries;
+        // std::list so that the IO slots below stay valid across insertions
+        std::list<Mmio> m_entries;
         std::unordered_map<u16, Mmio> m_fast_entries;
+        // Each page either points directly to the host memory backing it or
+        // is null, in which case accesses go through the entries above.
+        std::array<u8*, PAGE_COUNT> m_pages = {};
+        // Entry mapped at each address of the IO page (0xFF00-0xFFFF)
+        std::array<const Mmio*, PAGE_SIZE> m_io_slots = {};
     };
 
 public:
@@ -218,6 +321,18 @@ public:
         return remapWO(MmioWrite(addr, size, buff, mask));
     }
 
+    Result<void> mapRW(u16 addr, MmioReadHandler read, MmioWriteHandler write,
+                       u16 size = 1)
+    {
+        return mapRW(MmioRead(addr, size, read), MmioWrite(addr, size, write));
+    }
+    Result<void> remapRW(u16 addr, MmioReadHandler read,
+                         MmioWriteHandler write, u16 size = 1)
+    {
+        return remapRW(MmioRead(addr, size, read),
+                       MmioWrite(addr, size, write));
+    }
+
     Result<void> mapRW(u16 addr, MmioReadFunc read, MmioWriteFunc write,
                        u16 size = 1)
     {
@@ -235,8 +350,25 @@ public:
     // Result<void> write(u16 addr, const void* src, size_t size);
 
     // fast code path
-    Result<u8> read8(u16 addr);
-    Result<void> write8(u16 addr, u8 data);
+    Result<u8> read8(u16 addr)
+    {
+        if (const u8* page = m_read_map.m_pages[addr / PAGE_SIZE])
+            return page[addr % PAGE_SIZE];
+        return readSlow(addr);
+    }
+    Result<void> write8(u16 addr, u8 data)
+    {
+        if (u8* page = m_write_map.m_pages[addr / PAGE_SIZE])
+        {
+            page[addr % PAGE_SIZE] = data;
+            return {};
+        }
+        return writeSlow(addr, data);
+    }
+
+private:
+    Result<u8> readSlow(u16 addr);
+    Result<void> writeSlow(u16 addr, u8 data);
 
 private:
     Mapper m_read_map;
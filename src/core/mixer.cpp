@@ -0,0 +1,144 @@
+#include "mixer.hpp"
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace gbemu::core
+{
+
+// the NR50 volumes go from 1 to 8
+static constexpr size_t VOLUME_SHIFT = 3;
+// Q15 charge factor of the high-pass capacitor for one sample at 44100Hz
+static constexpr s32 HIGH_PASS_FACTOR = 32637;
+
+Mixer::Mixer() : m_gains{}, m_hp_input{}, m_hp_output{}
+{
+}
+
+void Mixer::setRouting(u8 nr50, u8 nr51)
+{
+    // left is SO2 (high nibbles), right is SO1 (low nibbles)
+    s16 volumes[2] = { static_cast<s16>(((nr50 >> 4) & 7) + 1),
+                       static_cast<s16>((nr50 & 7) + 1) };
+    u8 routes[2] = { static_cast<u8>(nr51 >> 4),
+                     static_cast<u8>(nr51 & 0xF) };
+
+    for (size_t side = 0; side < 2; side++)
+    {
+        for (size_t i = 0; i < CHANNELS; i++)
+            m_gains[side][i] = ((routes[side] >> i) & 1) ? volumes[side] : 0;
+    }
+}
+
+void Mixer::mixScalar(const s16* const* channels, s16* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t side = 0; side < 2; side++)
+        {
+            s32 sum = 0;
+            for (size_t ch = 0; ch < CHANNELS; ch++)
+                sum += channels[ch][i] * m_gains[side][ch];
+
+            out[i * 2 + side] = std::clamp<s32>(sum >> VOLUME_SHIFT, INT16_MIN,
+                                                INT16_MAX);
+        }
+    }
+
+    highPass(out, count);
+}
+
+#if defined(__SSE2__)
+
+void Mixer::mix(const s16* const* channels, s16* out, size_t count)
+{
+    // gains for interleaved pairs of channels (0, 1) and (2, 3)
+    __m128i gains[2][2];
+    for (size_t side = 0; side < 2; side++)
+    {
+        const s16* g = m_gains[side];
+        gains[side][0] = _mm_setr_epi16(g[0], g[1], g[0], g[1], g[0], g[1],
+                                        g[0], g[1]);
+        gains[side][1] = _mm_setr_epi16(g[2], g[3], g[2], g[3], g[2], g[3],
+                                        g[2], g[3]);
+    }
+
+    // 8 samples per iteration
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i ch[CHANNELS];
+        for (size_t c = 0; c < CHANNELS; c++)
+            ch[c] = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(channels[c] + i));
+
+        __m128i pairs[2][2] = {
+            { _mm_unpacklo_epi16(ch[0], ch[1]),
+              _mm_unpackhi_epi16(ch[0], ch[1]) },
+            { _mm_unpacklo_epi16(ch[2], ch[3]),
+              _mm_unpackhi_epi16(ch[2], ch[3]) },
+        };
+
+        // 32 bits sums, 4 samples per vector
+        __m128i sums[2][2];
+        for (size_t side = 0; side < 2; side++)
+        {
+            for (size_t half = 0; half < 2; half++)
+            {
+                __m128i lo = _mm_madd_epi16(pairs[0][half], gains[side][0]);
+                __m128i hi = _mm_madd_epi16(pairs[1][half], gains[side][1]);
+                sums[side][half] =
+                    _mm_srai_epi32(_mm_add_epi32(lo, hi), VOLUME_SHIFT);
+            }
+        }
+
+        // interleave left and right, then saturate to 16 bits
+        for (size_t half = 0; half < 2; half++)
+        {
+            __m128i a = _mm_unpacklo_epi32(sums[0][half], sums[1][half]);
+            __m128i b = _mm_unpackhi_epi32(sums[0][half], sums[1][half]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2 + half * 8),
+                             _mm_packs_epi32(a, b));
+        }
+    }
+
+    // the filter is recursive and runs on the whole block afterwards
+    highPass(out, i);
+
+    const s16* tail[CHANNELS];
+    for (size_t c = 0; c < CHANNELS; c++)
+        tail[c] = channels[c] + i;
+    mixScalar(tail, out + i * 2, count - i);
+}
+
+#else
+
+void Mixer::mix(const s16* const* channels, s16* out, size_t count)
+{
+    mixScalar(channels, out, count);
+}
+
+#endif
+
+void Mixer::highPass(s16* out, size_t count)
+{
+    for (size_t side = 0; side < 2; side++)
+    {
+        s32 input = m_hp_input[side];
+        s32 output = m_hp_output[side];
+
+        for (size_t i = 0; i < count; i++)
+        {
+            s32 x = out[i * 2 + side];
+            output = x - input + ((output * HIGH_PASS_FACTOR) >> 15);
+            input = x;
+            out[i * 2 + side] = std::clamp<s32>(output, INT16_MIN, INT16_MAX);
+        }
+
+        m_hp_input[side] = input;
+        m_hp_output[side] = output;
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "types.hpp"
+
+namespace gbemu::core
+{
+
+// Mixes the 4 APU channels into interleaved stereo samples, applying the
+// NR51 routing, the NR50 master volumes and a high-pass filter removing the
+// DC offset of the DACs (like the capacitors on the real outputs).
+class Mixer
+{
+public:
+    static constexpr size_t CHANNELS = 4;
+
+public:
+    Mixer();
+
+    void setRouting(u8 nr50, u8 nr51);
+
+    // `channels` point to `count` mono samples each, `out` receives `count`
+    // stereo samples
+    void mix(const s16* const* channels, s16* out, size_t count);
+    // portable version of `mix`, the vectorized one falls back to it
+    void mixScalar(const s16* const* channels, s16* out, size_t count);
+
+private:
+    void highPass(s16* out, size_t count);
+
+    s16 m_gains[2][CHANNELS]; // left, right
+    s32 m_hp_input[2];
+    s32 m_hp_output[2];
+};
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include "types.hpp"
+#include "optable_gen.hpp"
+
+namespace gbemu::core
+{
+
+// instruction properties, generated from tools/Opcodes.json
+struct OpInfo
+{
+    enum Flag : u8
+    {
+        KEEP,
+        RESET,
+        SET,
+        UPDATE,
+    };
+
+    enum Operand : u8
+    {
+        NONE,
+        IMM8,
+        IMM16,
+    };
+
+    bool valid;
+    u8 size;          // bytes, including the CB prefix
+    u8 cycles;        // T-states, branch not taken
+    u8 cycles_branch; // T-states, branch taken
+    Flag z;
+    Flag n;
+    Flag h;
+    Flag c;
+    Operand operand;
+    const char* disas; // fmt string taking the operand
+};
+
+#define OPINFO_ENTRY(op, name, size, cycles, cycles_branch, z, n, h, c,        \
+                     operand, disas)                                           \
+    OpInfo{ true,                                                              \
+            size,                                                              \
+            cycles,                                                            \
+            cycles_branch,                                                     \
+            OpInfo::z,                                                         \
+            OpInfo::n,                                                         \
+            OpInfo::h,                                                         \
+            OpInfo::c,                                                         \
+            OpInfo::operand,                                                   \
+            disas },
+#define OPINFO_ILLEGAL(op)                                                     \
+    OpInfo{ false,                                                             \
+            1,                                                                 \
+            4,                                                                 \
+            4,                                                                 \
+            OpInfo::KEEP,                                                      \
+            OpInfo::KEEP,                                                      \
+            OpInfo::KEEP,                                                      \
+            OpInfo::KEEP,                                                      \
+            OpInfo::NONE,                                                      \
+            "???" },
+
+static constexpr std::array<OpInfo, 0x100> OP_INFO = {
+    OPTABLE_UNPREFIXED(OPINFO_ENTRY, OPINFO_ILLEGAL)
+};
+static constexpr std::array<OpInfo, 0x100> CB_OP_INFO = {
+    OPTABLE_CBPREFIXED(OPINFO_ENTRY)
+};
+
+#undef OPINFO_ENTRY
+#undef OPINFO_ILLEGAL
+
+}
@@ -1,19 +1,50 @@
 #include "ppu.hpp"
+#include <algorithm>
 #include <cstring>
 #include "common/fs.hpp"
 #include "common/logging.hpp"
 #include "int_controller.hpp"
 #include "memory.hpp"
+#include "save_state.hpp"
+#include "scheduler.hpp"
+#include "tile_decode.hpp"
+
+namespace gbemu::core
+{
 
-static constexpr size_t TILE_WIDTH = 8;
-static constexpr size_t TILE_HEIGHT = 8;
 static constexpr size_t BG_TILES_X = 32;
 static constexpr size_t BG_TILES_Y = 32;
 static constexpr size_t BG_WIDTH = BG_TILES_X * TILE_WIDTH;
 static constexpr size_t BG_HEIGHT = BG_TILES_Y * TILE_HEIGHT;
 
-namespace gbemu::core
+static constexpr u32 DMG_COLORS[4] = {
+    0xFFFFFFFF,
+    0xFF555555,
+    0xFFAAAAAA,
+    0xFF000000,
+};
+
+static u32 dmgColor(u8 palette, u8 idx)
 {
+    return DMG_COLORS[(palette >> idx * 2) & 3];
+}
+
+void IndexedFrame::toRgba(u32* dst) const
+{
+    for (size_t y = 0; y < SCREEN_HEIGHT; y++)
+    {
+        u32 colors[16] = {};
+        for (u8 i = 0; i < 4; i++)
+        {
+            colors[i] = dmgColor(palettes[y][0], i);
+            colors[4 + i] = dmgColor(palettes[y][1], i);
+            colors[8 + i] = dmgColor(palettes[y][2], i);
+        }
+
+        applyPalette(pixels + y * SCREEN_WIDTH, colors, dst + y * SCREEN_WIDTH,
+                     SCREEN_WIDTH);
+    }
+}
 
 void Ppu::oamSearch(size_t screen_y)
 {
@@ -55,192 +86,193 @@ void Ppu::oamSearch(size_t screen_y)
     }
 }
 
-void Ppu::drawLine(size_t screen_y)
+void Ppu::drawBgSpan(u8* dst, const u8* map, size_t x, size_t y,
+                     size_t count)
 {
-    auto fetchTileColor = [](u8* tile_data, size_t tile_idx, size_t tile_x,
-                             size_t tile_y) ALWAYS_INLINE -> u8
-    {
-        u8 b0 = tile_data[tile_idx * 0x10 + tile_y * 2 + 0];
-        u8 b1 = tile_data[tile_idx * 0x10 + tile_y * 2 + 1];
-        u8 bit0 = (b0 >> (7 - tile_x)) & 1;
-        u8 bit1 = (b1 >> (7 - tile_x)) & 1;
-        u8 color_code = (bit0 << 1) | bit1;
-
-        return color_code;
-    };
-
-    auto fetchBgColorFromBgCoord =
-        [this, fetchTileColor](u8* tile_data, u8* tile_map, size_t bg_x,
-                               size_t bg_y) ALWAYS_INLINE -> u8
+    const u8* map_row = map + (y / TILE_HEIGHT) * BG_TILES_X;
+    size_t tile_y = y % TILE_HEIGHT;
+
+    // one tile row at a time, only the first and last ones can be partial
+    while (count > 0)
     {
-        size_t tile_x = bg_x / TILE_WIDTH;
-        size_t tile_y = bg_y / TILE_HEIGHT;
+        size_t tile_x = (x / TILE_WIDTH) % BG_TILES_X;
+        size_t off = x % TILE_WIDTH;
+        size_t n = std::min(TILE_WIDTH - off, count);
 
-        size_t tile_off_x = bg_x % TILE_WIDTH;
-        size_t tile_off_y = bg_y % TILE_HEIGHT;
+        const u8* src = tileRow(bgTileIndex(map_row[tile_x]), tile_y);
+        std::copy_n(src + off, n, dst);
 
-        u8 tile_idx = tile_map[tile_y * BG_TILES_X + tile_x];
-        if (!m_lcdc.bg_tile_area)
-            tile_idx ^= 0x80;
+        dst += n;
+        x += n;
+        count -= n;
+    }
+}
 
-        return fetchTileColor(tile_data, tile_idx, tile_off_x, tile_off_y);
-    };
+void Ppu::drawLine(size_t screen_y)
+{
+    // color codes
+    u8 bg_line[SCREEN_WIDTH] = {};
+    // color code | palette << 2, 0 is transparent
+    u8 obj_line[SCREEN_WIDTH] = {};
 
-    auto fetchBgColor = [this, fetchBgColorFromBgCoord](
-                            u8* tile_data, u8* tile_map, size_t screen_x,
-                            size_t screen_y) ALWAYS_INLINE -> u8
+    if (m_lcdc.bg_and_window_enable)
     {
-        size_t bg_x = (screen_x + m_scx) % BG_WIDTH;
-        size_t bg_y = (screen_y + m_scy) % BG_HEIGHT;
-
-        return fetchBgColorFromBgCoord(tile_data, tile_map, bg_x, bg_y);
-    };
+        size_t win_start = SCREEN_WIDTH;
+        if (m_lcdc.window_enable && screen_y >= m_wy)
+            win_start = std::min<size_t>(m_wx < 7 ? 0 : m_wx - 7, SCREEN_WIDTH);
+
+        drawBgSpan(bg_line, bgMap(), m_scx, (screen_y + m_scy) % BG_HEIGHT,
+                   win_start);
+        if (win_start < SCREEN_WIDTH)
+            drawBgSpan(bg_line + win_start, windowMap(), win_start + 7 - m_wx,
+                       screen_y - m_wy, SCREEN_WIDTH - win_start);
+    }
 
-    auto fetchWinColor = [this, fetchBgColorFromBgCoord](
-                             u8* tile_data, u8* tile_map, size_t screen_x,
-                             size_t screen_y) ALWAYS_INLINE -> u8
+    if (m_lcdc.obj_enable)
     {
-        size_t win_x = screen_x - m_wx + 7;
-        size_t win_y = screen_y - m_wy;
+        size_t sprite_height = m_lcdc.obj_size == 0 ? 8 : 16;
 
-        return fetchBgColorFromBgCoord(tile_data, tile_map, win_x, win_y);
-    };
-
-    auto fetchSpriteColor =
-        [this, fetchTileColor](OamEntry& oam, size_t sprite_x, size_t sprite_y,
-                               u8 bg_color) ALWAYS_INLINE -> std::tuple<u8, u8>
-    {
-        u8 tile_idx = oam.tile;
-        if (m_lcdc.obj_size == 1)
-            tile_idx &= ~1;
-        u8 sprite_color =
-            fetchTileColor(spriteTiles(), tile_idx, sprite_x, sprite_y);
-        u8 palette = oam.dmg_palette;
-
-        if (sprite_color == 0)
-            return { 0, 0 };
-        if (oam.bg_and_window_over_obj == 1 && bg_color != 0)
-            return { 0, 0 };
-        return { sprite_color, palette };
-    };
-
-    auto fetchSpriteLayerColor =
-        [this, fetchSpriteColor](u8* sprites, size_t sprite_count,
-                                 size_t screen_x, size_t screen_y, u8 bg_color)
-            ALWAYS_INLINE -> std::tuple<u8, u8>
-    {
-        for (size_t i = 0; i < sprite_count; i++)
+        // the first sprites have priority, so they are drawn last
+        for (size_t i = m_line_oam_count; i-- > 0;)
         {
-            auto& oam = m_oam[sprites[i]];
+            auto& oam = m_oam[m_line_oam[i]];
 
-            if (screen_x + 8 >= oam.x && screen_x < oam.x)
-            {
-                size_t sprite_x = screen_x + 8 - oam.x;
-                size_t sprite_y = screen_y + 16 - oam.y;
-                size_t sprite_height = m_lcdc.obj_size == 0 ? 8 : 16;
-
-                if (oam.flip_x)
-                    sprite_x = 7 - sprite_x;
-                if (oam.flip_y)
-                    sprite_y = sprite_height - 1 - sprite_y;
-
-                auto [color, palette] =
-                    fetchSpriteColor(oam, sprite_x, sprite_y, bg_color);
-                if (color != 0)
-                    return { color, palette };
-            }
-        }
-        return { 0, 0 };
-    };
+            size_t sprite_y = screen_y + 16 - oam.y;
+            if (oam.flip_y)
+                sprite_y = sprite_height - 1 - sprite_y;
 
-    u32* dst = m_screen_texture + SCREEN_WIDTH * screen_y;
-    u8* bg_map = bgMap();
-    u8* win_map = windowMap();
-    u8* tiles = bgTiles();
+            u8 tile_idx = oam.tile;
+            if (m_lcdc.obj_size == 1)
+                tile_idx &= ~1;
+            const u8* src = tileRow(tile_idx + sprite_y / TILE_HEIGHT,
+                                    sprite_y % TILE_HEIGHT);
 
-    for (size_t screen_x = 0; screen_x < SCREEN_WIDTH; screen_x++)
-    {
-        bool debug_win = false;
+            for (size_t x = 0; x < TILE_WIDTH; x++)
+            {
+                size_t screen_x = oam.x + x - 8;
+                if (screen_x >= SCREEN_WIDTH)
+                    continue;
 
-        u8 bg_color = 0;
-        if (m_lcdc.bg_and_window_enable)
-        {
-            bg_color = (m_lcdc.window_enable && screen_x + 7 >= m_wx &&
-                        screen_y >= m_wy)
-                           ? fetchWinColor(tiles, win_map, screen_x, screen_y)
-                           : fetchBgColor(tiles, bg_map, screen_x, screen_y);
-
-            // if (m_lcdc.window_enable)
-            // if (m_lcdc.window_enable && screen_x+7 >= m_wx && screen_y >=
-            // m_wy)
-            //     debug_win = true;
-        }
+                u8 color = src[oam.flip_x ? 7 - x : x];
+                if (color == 0)
+                    continue;
+                if (oam.bg_and_window_over_obj == 1 && bg_line[screen_x] != 0)
+                    continue;
 
-        auto [sprite_color, sprite_palette] =
-            m_lcdc.obj_enable
-                ? fetchSpriteLayerColor(m_line_oam, m_line_oam_count, screen_x,
-                                        screen_y, bg_color)
-                : std::tuple<u8, u8>{ 0, 0 };
-
-        *dst++ = sprite_color == 0
-                     ? getColor(m_dmg_bgp, bg_color, false)
-                     : getColor(m_dmg_obp[sprite_palette], sprite_color, false);
-        // if (debug_win)
-        //     dst[-1] = 0xFFFF0000;
+                obj_line[screen_x] = color | (oam.dmg_palette << 2);
+            }
+        }
     }
+
+    u8* dst = m_frame.pixels + SCREEN_WIDTH * screen_y;
+    for (size_t x = 0; x < SCREEN_WIDTH; x++)
+        dst[x] = obj_line[x] != 0 ? 4 + obj_line[x] : bg_line[x];
+
+    m_frame.palettes[screen_y][0] = m_dmg_bgp;
+    m_frame.palettes[screen_y][1] = m_dmg_obp[0];
+    m_frame.palettes[screen_y][2] = m_dmg_obp[1];
 }
 
 void Ppu::drawTile(u32* dst, u8* tile)
 {
+    u32 palette[16] = {};
+    for (u8 i = 0; i < 4; i++)
+        palette[i] = getColor(m_dmg_bgp, i, false);
+
     for (size_t y = 0; y < 8; y++)
     {
-        u8 b0 = *tile++;
-        u8 b1 = *tile++;
-
-        for (size_t x = 0; x < 8; x++)
-        {
-            u8 bit0 = (b0 >> (7 - x)) & 1;
-            u8 bit1 = (b1 >> (7 - x)) & 1;
-
-            dst[y * 32 * 8 + x] =
-                getColor(m_dmg_bgp, (bit0 << 1) | bit1, false);
-        }
+        u8 codes[8];
+        decodeTileRow(tile[y * 2], tile[y * 2 + 1], codes);
+        applyPalette(codes, palette, dst + y * 32 * 8, 8);
     }
 }
 
-void Ppu::drawTiles(bool bg)
+size_t Ppu::drawTiles(bool bg)
 {
+    if (!m_map_textures)
+    {
+        m_map_textures = std::make_unique<std::array<MapTexture, 2>>();
+        for (auto& tex : *m_map_textures)
+            tex.valid = false;
+    }
+
+    MapTexture& tex = (*m_map_textures)[bg ? 0 : 1];
     u8* map = bg ? bgMap() : windowMap();
-    u32* dst = bg ? m_bg_texture : m_window_texture;
-    u8* tiles = bgTiles();
+    u8 map_area = bg ? m_lcdc.bg_map_area : m_lcdc.window_map_area;
 
+    bool redraw_all = !tex.valid || tex.palette != m_dmg_bgp ||
+                      tex.map_area != map_area ||
+                      tex.tile_area != m_lcdc.bg_tile_area;
+
+    size_t redrawn = 0;
     for (size_t i = 0; i < 32 * 32; i++)
     {
-        u8 tile_off = m_lcdc.bg_tile_area ? map[i] : map[i] ^ 0x80;
-
-        u8* src = tiles + tile_off * 0x10;
+        size_t tile = bgTileIndex(map[i]);
+        if (!redraw_all && !tex.dirty_entries[i] && !tex.dirty_tiles[tile])
+            continue;
 
         size_t x = (i % 32) * 8;
         size_t y = (i / 32) * 8;
 
-        drawTile(dst + y * 32 * 8 + x, src);
+        drawTile(tex.pixels + y * 32 * 8 + x, vram() + tile * TILE_SIZE);
+        redrawn++;
     }
+
+    tex.dirty_tiles.reset();
+    tex.dirty_entries.reset();
+    tex.valid = true;
+    tex.palette = m_dmg_bgp;
+    tex.map_area = map_area;
+    tex.tile_area = m_lcdc.bg_tile_area;
+
+    return redrawn;
 }
 
-Ppu::Ppu(InterruptController* interrupt) :
+Ppu::Ppu(InterruptController* interrupt, Scheduler* scheduler) :
     m_interrupt(interrupt),
-    m_vram_bank(0)
+    m_scheduler(scheduler),
+    m_mem(nullptr),
+    m_vram_bank(0),
+    m_oam{},
+    m_dmg_bgp(0),
+    m_dmg_obp{},
+    m_frame_count(0),
+    m_frame_skip(0),
+    m_render_enabled(true),
+    m_render_frame(true),
+    m_lcdc{},
+    m_stat{},
+    m_dma(0),
+    m_dma_transfered(160),
+    m_line_oam{},
+    m_line_oam_count(0),
+    m_scy(0),
+    m_scx(0),
+    m_wy(0),
+    m_wx(0),
+    m_ly(0),
+    m_lyc(0)
 {
-    m_dmg_colors[0] = 0xFFFFFFFF;
-    m_dmg_colors[2] = 0xFFAAAAAA;
-    m_dmg_colors[1] = 0xFF555555;
-    m_dmg_colors[3] = 0xFF000000;
+    std::memset(m_vram, 0, sizeof(m_vram));
+    std::memset(m_tile_cache, 0, sizeof(m_tile_cache));
 
-    m_dma_transfered = 160;
+    std::memset(&m_frame, 0, sizeof(m_frame));
+
+    m_scheduler->setHandler(EventType_Ppu,
+                            Scheduler::handler<&Ppu::onModeEvent>(this));
+    m_scheduler->setHandler(EventType_Dma,
+                            Scheduler::handler<&Ppu::onDmaEvent>(this));
+
+    // the first line starts with an OAM search at clock 0
+    setLy(0);
+    m_stat.mode = PpuMode_OamSearch;
+    m_scheduler->schedule(EventType_Ppu, OAM_CYCLES);
 }
 
 void Ppu::mapMemory(Memory* mem)
 {
+    m_mem = mem;
+
     mem->mapRW(OAM_START, oam(), OAM_SIZE);
 
     mem->mapRW(BGP_ADDR, &m_dmg_bgp, 1);
@@ -251,116 +283,254 @@ void Ppu::mapMemory(Memory* mem)
     mem->mapRW(LCDC_ADDR, &m_lcdc);
     mem->mapRW(STAT_ADDR, &m_stat, 1, 0b01111100);
     mem->mapRO(LY_ADDR, &m_ly);
-    mem->mapRW(LYC_ADDR, &m_lyc);
+    mem->mapRW(
+        MmioRead(LYC_ADDR, 1, &m_lyc),
+        MmioWrite(LYC_ADDR, 1, MmioWrite::handler<&Ppu::writeLyc>(this)));
     mem->mapRW(WX_ADDR, &m_wx);
     mem->mapRW(WY_ADDR, &m_wy);
 
-    mem->mapRW(DMA_ADDR, MmioRead::readFunc(&m_dma),
-               std::bind(&Ppu::startDMA, this, std::placeholders::_1,
-                         std::placeholders::_2));
+    mem->mapRW(
+        MmioRead(DMA_ADDR, 1, &m_dma),
+        MmioWrite(DMA_ADDR, 1, MmioWrite::handler<&Ppu::startDMA>(this)));
 
     switchBank(mem, 0);
 }
 
+void Ppu::saveState(StateWriter& state)
+{
+    state.write(m_vram_bank);
+    state.write(m_vram);
+    state.write(m_oam);
+
+    state.write(m_dmg_bgp);
+    state.write(m_dmg_obp);
+    state.write(m_frame_count);
+    state.write(m_render_frame);
+
+    state.write(m_lcdc);
+    state.write(m_stat);
+    state.write(m_dma);
+    state.write(m_dma_transfered);
+    state.write(m_line_oam);
+    state.write(m_line_oam_count);
+    state.write(m_scy);
+    state.write(m_scx);
+    state.write(m_wy);
+    state.write(m_wx);
+    state.write(m_ly);
+    state.write(m_lyc);
+
+    // so that the screen is right until the next frame is drawn
+    state.write(m_frame);
+}
+
+void Ppu::loadState(StateReader& state)
+{
+    size_t bank = 0;
+    u8 vram[2][VRAM_SIZE] = {};
+    state.read(bank);
+    state.read(vram);
+    state.read(m_oam);
+
+    state.read(m_dmg_bgp);
+    state.read(m_dmg_obp);
+    state.read(m_frame_count);
+    state.read(m_render_frame);
+
+    state.read(m_lcdc);
+    state.read(m_stat);
+    state.read(m_dma);
+    state.read(m_dma_transfered);
+    state.read(m_line_oam);
+    state.read(m_line_oam_count);
+    state.read(m_scy);
+    state.read(m_scx);
+    state.read(m_wy);
+    state.read(m_wx);
+    state.read(m_ly);
+    state.read(m_lyc);
+
+    state.read(m_frame);
+
+    // Only the tile rows that changed are decoded again. That's most of
+    // them for a new instance, but only a few when rewinding.
+    for (size_t b = 0; b < 2; b++)
+    {
+        for (size_t row = 0; row < TILE_COUNT * TILE_HEIGHT; row++)
+        {
+            u8* src = &vram[b][row * 2];
+            u8* dst = &m_vram[b][row * 2];
+            if (src[0] == dst[0] && src[1] == dst[1])
+                continue;
+
+            dst[0] = src[0];
+            dst[1] = src[1];
+            updateTileCache(b, row);
+        }
+    }
+    std::memcpy(m_vram, vram, sizeof(m_vram));
+    if (m_map_textures)
+    {
+        for (auto& tex : *m_map_textures)
+            tex.valid = false;
+    }
+
+    switchBank(m_mem, bank & 1);
+}
+
 Result<void> Ppu::startDMA(u16 off, u8 addr)
 {
     m_dma = addr;
     m_dma_transfered = 0;
+    m_scheduler->schedule(EventType_Dma, m_scheduler->clocks() + 4);
+    return {};
+}
+
+Result<void> Ppu::writeLyc(u16 off, u8 data)
+{
+    m_lyc = data;
+    setLy(m_ly);
+    return {};
+}
+
+Result<void> Ppu::writeVram(u16 off, u8 data)
+{
+    vram()[off] = data;
+
+    if (off < TILE_COUNT * TILE_SIZE)
+        updateTileCache(m_vram_bank, off / 2);
+
+    if (!m_map_textures)
+        return {};
+
+    for (auto& tex : *m_map_textures)
+    {
+        if (off < TILE_COUNT * TILE_SIZE)
+            tex.dirty_tiles.set(off / TILE_SIZE);
+        // two 32x32 maps
+        else if (tex.map_area == (off - TILE_COUNT * TILE_SIZE) / 0x400)
+            tex.dirty_entries.set(off % 0x400);
+    }
     return {};
 }
 
+void Ppu::updateTileCache(size_t bank, size_t row)
+{
+    decodeTileRow(m_vram[bank][row * 2 + 0], m_vram[bank][row * 2 + 1],
+                  m_tile_cache[bank][row]);
+}
+
 void Ppu::switchBank(Memory* mem, size_t bank)
 {
     m_vram_bank = bank;
-    mem->mapRW(VRAM_START, vram(), VRAM_SIZE);
+    // reads go straight to VRAM, writes also update the tile cache
+    mem->remapRW(MmioRead(VRAM_START, VRAM_SIZE, vram()),
+                 MmioWrite(VRAM_START, VRAM_SIZE,
+                           MmioWrite::handler<&Ppu::writeVram>(this)));
 }
 
 u32 Ppu::getColor(u8 palette, u8 idx, bool transparency)
 {
-    u8 code = (palette >> idx * 2) & 3;
-
-    if (transparency && code == 0)
+    if (transparency && ((palette >> idx * 2) & 3) == 0)
         return 0x00000000;
 
-    return m_dmg_colors[code];
+    return dmgColor(palette, idx);
 }
 
-void Ppu::step(Memory* mem, size_t clocks)
+void Ppu::onDmaEvent(size_t clocks)
 {
-    // todo: cleanup
-    static size_t last_clocks = 0;
-    static size_t clocks_diff = clocks - last_clocks;
+    u8* dst = reinterpret_cast<u8*>(m_oam) + m_dma_transfered;
+    u16 src_addr = (m_dma << 8) + m_dma_transfered;
 
-    if (m_dma_transfered < 160)
-    {
-        u8* dst = reinterpret_cast<u8*>(m_oam) + m_dma_transfered;
-        u16 src_addr = (m_dma << 8) + m_dma_transfered;
+    // one byte per machine cycle
+    *dst = m_mem->read8(src_addr).value_or(0);
+    m_dma_transfered++;
 
-        for (size_t i = 0; i < clocks_diff / 4 && m_dma_transfered < 160; i++)
-        {
-            *dst++ = mem->read8(src_addr++).value_or(0);
-            m_dma_transfered++;
-        }
-    }
-
-    constexpr size_t oam_cycles = 20 * 4;
-    constexpr size_t transfer_cycles = 43 * 4;
-    constexpr size_t hblank_cycles = 41 * 4;
-    constexpr size_t transfer_off = oam_cycles;
-    constexpr size_t hblank_off = transfer_off + transfer_cycles;
-    constexpr size_t line_cycles = oam_cycles + transfer_cycles + hblank_cycles;
-    constexpr size_t vblank_cycles = line_cycles * 10;
-    constexpr size_t screen_cycles = line_cycles * (SCREEN_HEIGHT + 10);
-    size_t line_off = clocks % line_cycles;
+    if (m_dma_transfered < 160)
+        m_scheduler->schedule(EventType_Dma, clocks + 4);
+}
 
-    m_ly = (clocks % screen_cycles) / line_cycles;
+void Ppu::setLy(u8 ly)
+{
+    m_ly = ly;
 
-    m_stat.lyc_eq_lc = m_ly == m_lyc;
-    if (m_stat.lyc_eq_lc && m_stat.lyc_int_enable)
+    bool lyc_eq_lc = m_ly == m_lyc;
+    if (lyc_eq_lc && !m_stat.lyc_eq_lc && m_stat.lyc_int_enable)
         m_interrupt->requestInterrupt(InterruptType_LCDSTA);
+    m_stat.lyc_eq_lc = lyc_eq_lc;
+}
 
-    PpuMode prev_mode = m_stat.mode;
+void Ppu::setMode(PpuMode mode)
+{
+    m_stat.mode = mode;
 
-    if (m_ly > SCREEN_HEIGHT)
+    switch (mode)
     {
-        if (prev_mode != PpuMode_VBlank)
-        {
-            m_stat.mode = PpuMode_VBlank;
-            if (m_stat.vblank_int_enable)
+        case PpuMode_OamSearch:
+            if (m_stat.oam_int_enable)
                 m_interrupt->requestInterrupt(InterruptType_LCDSTA);
-        }
-    }
-    else if (line_off >= hblank_off)
-    {
-        if (prev_mode != PpuMode_HBlank)
-        {
-            m_stat.mode = PpuMode_HBlank;
+            if (m_ly == 0)
+                m_render_frame = m_render_enabled &&
+                                 m_frame_count % (m_frame_skip + 1) == 0;
+            if (m_render_frame)
+                oamSearch(m_ly);
+            break;
+        case PpuMode_PixelTransfer: break;
+        case PpuMode_HBlank:
             if (m_stat.hblank_int_enable)
                 m_interrupt->requestInterrupt(InterruptType_LCDSTA);
-
-            drawLine(m_ly);
-        }
-    }
-    else if (line_off >= transfer_off)
-    {
-        if (prev_mode != PpuMode_PixelTransfer)
-            m_stat.mode = PpuMode_PixelTransfer;
-    }
-    else if (prev_mode != PpuMode_OamSearch)
-    {
-        m_stat.mode = PpuMode_OamSearch;
-        if (m_stat.oam_int_enable)
-            m_interrupt->requestInterrupt(InterruptType_LCDSTA);
-
-        oamSearch(m_ly);
+            if (m_render_frame)
+                drawLine(m_ly);
+            break;
+        case PpuMode_VBlank:
+            if (m_stat.vblank_int_enable)
+                m_interrupt->requestInterrupt(InterruptType_LCDSTA);
+            m_interrupt->requestInterrupt(InterruptType_Vblank);
+            // drawTiles(true);
+            // drawTiles(false);
+            m_frame_count++;
+            break;
     }
+}
 
-    if (prev_mode == PpuMode_HBlank && m_stat.mode == PpuMode_VBlank)
+void Ppu::onModeEvent(size_t clocks)
+{
+    switch (m_stat.mode)
     {
-        m_interrupt->requestInterrupt(InterruptType_Vblank);
-        // drawTiles(true);
-        // drawTiles(false);
-        m_new_frame_available = true;
+        case PpuMode_OamSearch:
+            setMode(PpuMode_PixelTransfer);
+            m_scheduler->schedule(EventType_Ppu, clocks + TRANSFER_CYCLES);
+            break;
+        case PpuMode_PixelTransfer:
+            setMode(PpuMode_HBlank);
+            m_scheduler->schedule(EventType_Ppu, clocks + HBLANK_CYCLES);
+            break;
+        case PpuMode_HBlank:
+            setLy(m_ly + 1);
+            if (m_ly == SCREEN_HEIGHT)
+            {
+                setMode(PpuMode_VBlank);
+                m_scheduler->schedule(EventType_Ppu, clocks + LINE_CYCLES);
+            }
+            else
+            {
+                setMode(PpuMode_OamSearch);
+                m_scheduler->schedule(EventType_Ppu, clocks + OAM_CYCLES);
+            }
+            break;
+        case PpuMode_VBlank:
+            if (m_ly + 1 == SCREEN_HEIGHT + VBLANK_LINES)
+            {
+                setLy(0);
+                setMode(PpuMode_OamSearch);
+                m_scheduler->schedule(EventType_Ppu, clocks + OAM_CYCLES);
+            }
+            else
+            {
+                setLy(m_ly + 1);
+                m_scheduler->schedule(EventType_Ppu, clocks + LINE_CYCLES);
+            }
+            break;
     }
 }
 
@@ -369,7 +539,7 @@ void Ppu::dumpBg()
     drawTiles(true);
     fmt::print("Dumping background\n");
     fmt::print("palette : 0x{:02X}\n", m_dmg_bgp);
-    File::writeAllBytes("bg.raw", m_bg_texture, sizeof(m_bg_texture));
+    File::writeAllBytes("bg.raw", bgTexture(), sizeof(MapTexture::pixels));
     File::writeAllBytes("bg_map.bin", bgMap(), 32 * 32 * 0x10);
     File::writeAllBytes("window_map.bin", windowMap(), 32 * 32 * 0x10);
     File::writeAllBytes("bg_tiles.bin", bgTiles(), 0x100 * 0x10);
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <memory>
 #include "device.hpp"
 #include "io.hpp"
 #include "result.hpp"
@@ -8,10 +11,26 @@ namespace gbemu::core
 {
 
 class InterruptController;
+class Scheduler;
 
 static constexpr size_t SCREEN_WIDTH = 160;
 static constexpr size_t SCREEN_HEIGHT = 144;
 
+static constexpr size_t TILE_WIDTH = 8;
+static constexpr size_t TILE_HEIGHT = 8;
+static constexpr size_t TILE_SIZE = 0x10; // 2bpp
+static constexpr size_t TILE_COUNT = 384; // 0x8000-0x97FF
+
+// T-states
+static constexpr size_t OAM_CYCLES = 20 * 4;
+static constexpr size_t TRANSFER_CYCLES = 43 * 4;
+static constexpr size_t HBLANK_CYCLES = 41 * 4;
+static constexpr size_t LINE_CYCLES =
+    OAM_CYCLES + TRANSFER_CYCLES + HBLANK_CYCLES;
+static constexpr size_t VBLANK_LINES = 10;
+static constexpr size_t FRAME_CYCLES =
+    LINE_CYCLES * (SCREEN_HEIGHT + VBLANK_LINES);
+
 struct OamEntry
 {
     u8 y;
@@ -26,6 +45,17 @@ struct OamEntry
 } PACKED;
 static_assert(sizeof(OamEntry) == 4);
 
+// Frame as drawn by the PPU: palette indices plus the palettes each line was
+// drawn with, only converted to RGBA when it gets presented.
+struct IndexedFrame
+{
+    // 0-3 BGP, 4-7 OBP0, 8-11 OBP1
+    u8 pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
+    u8 palettes[SCREEN_HEIGHT][3]; // BGP, OBP0, OBP1
+
+    void toRgba(u32* dst) const;
+};
+
 enum PpuMode : u8
 {
     PpuMode_HBlank,
@@ -37,16 +67,20 @@ enum PpuMode : u8
 class Ppu : public Device
 {
 public:
-    Ppu(InterruptController* interrupt);
+    Ppu(InterruptController* interrupt, Scheduler* scheduler);
 
 public:
     virtual void mapMemory(Memory* mem) override;
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
 
     auto vram() { return m_vram[m_vram_bank]; }
     auto oam() { return m_oam; }
     void switchBank(Memory* mem, size_t bank);
 
-    void step(Memory* mem, size_t clocks);
+    // scheduler events
+    void onModeEvent(size_t clocks);
+    void onDmaEvent(size_t clocks);
 
     u32 getColor(u8 palette, u8 idx, bool transparency);
 
@@ -59,30 +93,78 @@ public:
     }
 
     Result<void> startDMA(u16 off, u8 addr);
+    Result<void> writeLyc(u16 off, u8 data);
+    Result<void> writeVram(u16 off, u8 data);
 
     void drawLine(size_t screen_y);
     void oamSearch(size_t screen_y);
 
-    void drawTiles(bool bg);
+    // updates the BG/window map debug textures, returns the number of tiles
+    // redrawn
+    size_t drawTiles(bool bg);
     void drawTile(u32* dst, u8* tile);
+    // null until drawTiles() is first called
+    const u32* bgTexture() const
+    {
+        return m_map_textures ? (*m_map_textures)[0].pixels : nullptr;
+    }
+    const u32* windowTexture() const
+    {
+        return m_map_textures ? (*m_map_textures)[1].pixels : nullptr;
+    }
 
     void dumpBg();
 
-    void render();
+    const IndexedFrame& frame() const { return m_frame; }
 
-    bool newFrameAvailable() const { return m_new_frame_available; }
+    // Only one frame out of `skip + 1` is drawn, skipped frames keep the last
+    // drawn picture. Timings and interrupts are not affected.
+    void setFrameSkip(size_t skip) { m_frame_skip = skip; }
+    // nothing is drawn at all while disabled
+    void setRenderEnabled(bool enabled) { m_render_enabled = enabled; }
+    // whether the current frame (or the one that just ended during VBlank)
+    // is being drawn
+    bool isFrameRendered() const { return m_render_frame; }
+    // number of VBlanks since power on
+    size_t frameCount() const { return m_frame_count; }
 
     auto lcdc() { return m_lcdc; }
 
+private:
+    void setMode(PpuMode mode);
+    void setLy(u8 ly);
+
+    void updateTileCache(size_t bank, size_t row);
+    // decoded color codes of a row, `tile` indexes the whole tile data area
+    const u8* tileRow(size_t tile, size_t row)
+    {
+        return m_tile_cache[m_vram_bank][tile * TILE_HEIGHT + row];
+    }
+    size_t bgTileIndex(u8 map_entry)
+    {
+        // 0x8800 addressing uses signed indices relative to 0x9000
+        return m_lcdc.bg_tile_area ? map_entry
+                                   : 0x100 + static_cast<s8>(map_entry);
+    }
+    // count pixels of a BG/window line starting at map coordinates (x, y)
+    void drawBgSpan(u8* dst, const u8* map, size_t x, size_t y, size_t count);
+
 private:
     InterruptController* m_interrupt;
+    Scheduler* m_scheduler;
+    Memory* m_mem;
     size_t m_vram_bank;
     u8 m_vram[2][VRAM_SIZE]; // switchable bank in CGB mode
+    // tile data decoded to one color code per byte, updated on VRAM writes
+    u8 m_tile_cache[2][TILE_COUNT * TILE_HEIGHT][TILE_WIDTH];
     OamEntry m_oam[40];
 
     u8 m_dmg_bgp;    // non-CGB
     u8 m_dmg_obp[2]; // non-CGB
-    bool m_new_frame_available;
+    size_t m_frame_count;
+    size_t m_frame_skip;
+    bool m_render_enabled;
+    bool m_render_frame;
 
     union
     {
@@ -125,11 +207,22 @@ private:
     u8 m_ly;
     u8 m_lyc;
 
-    u32 m_dmg_colors[4];
-
-    u32 m_screen_texture[SCREEN_WIDTH * SCREEN_HEIGHT];
-    u32 m_bg_texture[32 * 32 * 8 * 8];
-    u32 m_window_texture[32 * 32 * 8 * 8];
+    IndexedFrame m_frame;
+    // Debug views of the BG/window maps. VRAM writes mark the tiles and map
+    // entries they touch so only those are redrawn.
+    struct MapTexture
+    {
+        u32 pixels[32 * 32 * 8 * 8];
+        std::bitset<TILE_COUNT> dirty_tiles;
+        std::bitset<32 * 32> dirty_entries;
+        // settings it was last drawn with, any change redraws everything
+        bool valid;
+        u8 palette;
+        u8 map_area;
+        u8 tile_area;
+    };
+    // BG, window, allocated on demand as most instances never show them
+    std::unique_ptr<std::array<MapTexture, 2>> m_map_textures;
 };
 
 }
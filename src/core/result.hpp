@@ -10,6 +10,11 @@ enum Error
     Error_InvalidRom,
     Errro_InvalidBootromSize,
 
+    // Cart
+    CartError_RomTooSmall,
+    CartError_InvalidRomSize,
+    CartError_UnsupportedType,
+
     // Memory
     MemoryError_WriteToReadOnlyAddress,
     MemoryError_ReadToWriteOnlyAddress,
@@ -22,6 +27,12 @@ enum Error
     MemoryError_CannotFindMapped,
     MemoryError_RemapWithDifferentSize,
     MemoryError_RemapWithDifferentAddr,
+
+    // Save state
+    StateError_BufferTooSmall,
+    StateError_InvalidHeader,
+    StateError_UnsupportedVersion,
+    StateError_CartMismatch,
 };
 
 template<typename T>
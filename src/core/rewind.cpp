@@ -0,0 +1,182 @@
+#include "rewind.hpp"
+#include <algorithm>
+#include <cstring>
+#include "gameboy.hpp"
+
+namespace gbemu::core
+{
+
+// words covered by one run of a delta
+static constexpr size_t MAX_RUN = 0xFFFF;
+
+RewindBuffer::RewindBuffer(size_t capacity, size_t interval) :
+    m_interval(std::max<size_t>(interval, 1)),
+    m_frames(0),
+    m_state_size(0),
+    m_has_current(false),
+    m_ring(capacity)
+{
+}
+
+void RewindBuffer::clear()
+{
+    m_frames = 0;
+    m_has_current = false;
+    m_entries.clear();
+}
+
+size_t RewindBuffer::used() const
+{
+    size_t used = 0;
+    for (auto& entry : m_entries)
+        used += entry.size;
+    return used;
+}
+
+void RewindBuffer::onFrame(Gameboy* gb)
+{
+    if (++m_frames < m_interval)
+        return;
+    m_frames = 0;
+
+    // only changes with the cartridge
+    size_t size = gb->stateSize();
+    if (size != m_state_size)
+    {
+        clear();
+        m_state_size = size;
+        size_t words = (size + sizeof(u64) - 1) / sizeof(u64);
+        // the padding stays zero
+        m_current.assign(words, 0);
+        m_next.assign(words, 0);
+        // worst case is one run per word
+        m_delta.resize(words * (sizeof(u64) + 2 * sizeof(u16)));
+    }
+
+    if (!gb->saveState(stateBytes(m_next)))
+        return;
+
+    if (m_has_current)
+        push(encode(m_current.data(), m_next.data(), m_next.size(),
+                    m_delta.data()));
+
+    std::swap(m_current, m_next);
+    m_has_current = true;
+}
+
+bool RewindBuffer::rewind(Gameboy* gb)
+{
+    if (!m_has_current)
+        return false;
+
+    if (!gb->loadState(stateBytes(m_current)))
+    {
+        clear();
+        return false;
+    }
+
+    // step back to the state before
+    if (m_entries.empty())
+        m_has_current = false;
+    else
+    {
+        Entry entry = m_entries.back();
+        m_entries.pop_back();
+        decode(m_ring.data() + entry.offset, entry.size, m_current.data());
+    }
+
+    // a full interval before the next capture
+    m_frames = 0;
+    return true;
+}
+
+void RewindBuffer::push(size_t size)
+{
+    if (size > m_ring.size())
+    {
+        // the older states can't be reached anymore
+        m_entries.clear();
+        return;
+    }
+
+    size_t offset = 0;
+    if (!m_entries.empty())
+        offset = m_entries.back().offset + m_entries.back().size;
+
+    if (offset + size > m_ring.size())
+    {
+        // wrap around, whatever is left at the end is the oldest
+        while (!m_entries.empty() && m_entries.front().offset >= offset)
+            m_entries.pop_front();
+        offset = 0;
+    }
+
+    // drop the oldest entries in the way
+    while (!m_entries.empty() && m_entries.front().offset >= offset &&
+           m_entries.front().offset < offset + size)
+        m_entries.pop_front();
+
+    std::memcpy(m_ring.data() + offset, m_delta.data(), size);
+    m_entries.push_back({ offset, size });
+}
+
+// A delta is a list of runs: the number of unchanged words to skip and the
+// number of changed words that follow, as two u16, then the changed words
+// XORed. Unchanged words at the end are not stored.
+size_t RewindBuffer::encode(const u64* a, const u64* b, size_t words, u8* dst)
+{
+    u8* out = dst;
+    size_t i = 0;
+
+    while (i < words)
+    {
+        size_t start = i;
+        while (i < words && a[i] == b[i] && i - start < MAX_RUN)
+            i++;
+        if (i == words)
+            break;
+        u16 skip = i - start;
+
+        start = i;
+        while (i < words && a[i] != b[i] && i - start < MAX_RUN)
+            i++;
+        u16 count = i - start;
+
+        std::memcpy(out, &skip, sizeof(skip));
+        std::memcpy(out + sizeof(skip), &count, sizeof(count));
+        out += 2 * sizeof(u16);
+
+        for (size_t j = start; j < i; j++)
+        {
+            u64 x = a[j] ^ b[j];
+            std::memcpy(out, &x, sizeof(x));
+            out += sizeof(x);
+        }
+    }
+
+    return out - dst;
+}
+
+void RewindBuffer::decode(const u8* src, size_t size, u64* dst)
+{
+    const u8* end = src + size;
+
+    while (src < end)
+    {
+        u16 skip, count;
+        std::memcpy(&skip, src, sizeof(skip));
+        std::memcpy(&count, src + sizeof(skip), sizeof(count));
+        src += 2 * sizeof(u16);
+
+        dst += skip;
+        for (size_t i = 0; i < count; i++)
+        {
+            u64 x;
+            std::memcpy(&x, src, sizeof(x));
+            *dst++ ^= x;
+            src += sizeof(x);
+        }
+    }
+}
+
+}
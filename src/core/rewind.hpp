@@ -0,0 +1,67 @@
+#pragma once
+
+#include <deque>
+#include <span>
+#include <vector>
+#include "types.hpp"
+
+namespace gbemu::core
+{
+
+class Gameboy;
+
+// History of save states to step back in time.
+// Only the most recent state is kept whole. Every older one is stored as the
+// XOR against the state that follows it, with the runs of unchanged words
+// skipped, so a state mostly costs what changed since the previous one. The
+// deltas live in a fixed-size ring, the oldest ones are dropped to make room.
+class RewindBuffer
+{
+public:
+    // capacity is the size of the ring in bytes, a state is captured every
+    // `interval` frames
+    RewindBuffer(size_t capacity, size_t interval);
+
+    // call once per emulated frame
+    void onFrame(Gameboy* gb);
+    // restores the most recent state and forgets it, returns false once the
+    // history is exhausted
+    bool rewind(Gameboy* gb);
+    void clear();
+
+    // number of states that can be restored
+    size_t count() const { return m_has_current ? m_entries.size() + 1 : 0; }
+    // bytes used in the ring
+    size_t used() const;
+
+private:
+    void push(size_t size);
+    std::span<u8> stateBytes(std::vector<u64>& words)
+    {
+        return { reinterpret_cast<u8*>(words.data()), m_state_size };
+    }
+
+    // writes the delta from `a` to `b` to dst, returns its size
+    static size_t encode(const u64* a, const u64* b, size_t words, u8* dst);
+    // applies a delta in place
+    static void decode(const u8* src, size_t size, u64* dst);
+
+private:
+    struct Entry
+    {
+        size_t offset;
+        size_t size;
+    };
+
+    size_t m_interval;
+    size_t m_frames; // since the last capture
+    size_t m_state_size;
+    bool m_has_current;
+    std::vector<u64> m_current; // most recent state
+    std::vector<u64> m_next;    // state being captured
+    std::vector<u8> m_delta;    // delta being encoded
+    std::vector<u8> m_ring;
+    std::deque<Entry> m_entries; // oldest first
+};
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include "types.hpp"
+
+namespace gbemu::core
+{
+
+// bump whenever the state of any device changes
+static constexpr u32 SAVE_STATE_VERSION = 1;
+
+// Device state is copied raw in a fixed order, without per-field tags or
+// allocations, so saving and loading are a series of memcpy into a single
+// contiguous buffer. Without a buffer, the writer only counts the size.
+class StateWriter
+{
+public:
+    StateWriter() : m_data(nullptr), m_capacity(0), m_size(0) {}
+    StateWriter(std::span<u8> buffer) :
+        m_data(buffer.data()),
+        m_capacity(buffer.size()),
+        m_size(0)
+    {
+    }
+
+    void write(const void* data, size_t size)
+    {
+        if (m_data && m_size + size <= m_capacity)
+            std::memcpy(m_data + m_size, data, size);
+        m_size += size;
+    }
+    template<typename T>
+    void write(const T& x)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(&x, sizeof(T));
+    }
+
+    // bytes written so far, including the ones that did not fit
+    size_t size() const { return m_size; }
+    bool overflowed() const { return m_size > m_capacity; }
+
+private:
+    u8* m_data;
+    size_t m_capacity;
+    size_t m_size;
+};
+
+class StateReader
+{
+public:
+    StateReader(std::span<const u8> buffer) :
+        m_data(buffer.data()),
+        m_capacity(buffer.size()),
+        m_size(0)
+    {
+    }
+
+    // out of bounds reads leave the destination untouched
+    void read(void* data, size_t size)
+    {
+        if (m_size + size <= m_capacity)
+            std::memcpy(data, m_data + m_size, size);
+        m_size += size;
+    }
+    template<typename T>
+    void read(T& x)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        read(&x, sizeof(T));
+    }
+
+    size_t size() const { return m_size; }
+    bool overflowed() const { return m_size > m_capacity; }
+
+private:
+    const u8* m_data;
+    size_t m_capacity;
+    size_t m_size;
+};
+
+}
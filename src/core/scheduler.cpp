@@ -0,0 +1,81 @@
+#include "scheduler.hpp"
+#include "save_state.hpp"
+
+namespace gbemu::core
+{
+
+Scheduler::Scheduler() :
+    m_clocks(0),
+    m_next_event(NEVER),
+    m_next_type(EventType_Count)
+{
+    m_deadlines.fill(NEVER);
+    m_handlers.fill({ nullptr, nullptr });
+}
+
+void Scheduler::setHandler(EventType type, EventHandler handler)
+{
+    m_handlers[type] = handler;
+}
+
+void Scheduler::schedule(EventType type, size_t clocks)
+{
+    m_deadlines[type] = clocks;
+
+    if (clocks < m_next_event)
+    {
+        m_next_event = clocks;
+        m_next_type = type;
+    }
+    else if (type == m_next_type)
+        updateNextEvent();
+}
+
+void Scheduler::sync(size_t clocks)
+{
+    while (m_next_event <= clocks)
+    {
+        EventType type = m_next_type;
+        size_t deadline = m_next_event;
+
+        m_deadlines[type] = NEVER;
+        updateNextEvent();
+
+        // handlers see the clock of their own event
+        m_clocks = deadline;
+        m_handlers[type].func(m_handlers[type].ctx, deadline);
+    }
+
+    if (clocks > m_clocks)
+        m_clocks = clocks;
+}
+
+void Scheduler::saveState(StateWriter& state)
+{
+    state.write(m_clocks);
+    state.write(m_deadlines);
+}
+
+void Scheduler::loadState(StateReader& state)
+{
+    state.read(m_clocks);
+    state.read(m_deadlines);
+    updateNextEvent();
+}
+
+void Scheduler::updateNextEvent()
+{
+    m_next_event = NEVER;
+    m_next_type = EventType_Count;
+
+    for (size_t i = 0; i < EventType_Count; i++)
+    {
+        if (m_deadlines[i] < m_next_event)
+        {
+            m_next_event = m_deadlines[i];
+            m_next_type = (EventType)i;
+        }
+    }
+}
+
+}
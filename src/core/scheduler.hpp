@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include "types.hpp"
+
+namespace gbemu::core
+{
+
+class StateReader;
+class StateWriter;
+
+enum EventType : u8
+{
+    EventType_Timer,  // TIMA overflow
+    EventType_Ppu,    // PPU mode change / LY increment
+    EventType_Dma,    // OAM DMA byte
+    EventType_Apu,    // audio output
+    EventType_Serial, // serial bit
+
+    EventType_Count,
+};
+
+// called with the clock the event was scheduled at
+struct EventHandler
+{
+    void (*func)(void* ctx, size_t clocks);
+    void* ctx;
+};
+
+// One deadline per event type, keyed on the system clock (T-states).
+class Scheduler
+{
+public:
+    static constexpr size_t NEVER = std::numeric_limits<size_t>::max();
+
+public:
+    Scheduler();
+
+    // Handler calling T::Func(clocks) on obj
+    template<auto Func, typename T>
+    static EventHandler handler(T* obj)
+    {
+        return { [](void* ctx, size_t clocks)
+                 { (static_cast<T*>(ctx)->*Func)(clocks); },
+                 obj };
+    }
+
+    void setHandler(EventType type, EventHandler handler);
+    void schedule(EventType type, size_t clocks);
+    void cancel(EventType type) { schedule(type, NEVER); }
+
+    // runs every event due up to the given clock, in order
+    void sync(size_t clocks);
+
+    size_t clocks() const { return m_clocks; }
+    size_t nextEvent() const { return m_next_event; }
+    size_t deadline(EventType type) const { return m_deadlines[type]; }
+
+    // the handlers are not part of the state
+    void saveState(StateWriter& state);
+    void loadState(StateReader& state);
+
+private:
+    void updateNextEvent();
+
+private:
+    size_t m_clocks; // T-states
+    size_t m_next_event;
+    EventType m_next_type;
+    std::array<size_t, EventType_Count> m_deadlines;
+    std::array<EventHandler, EventType_Count> m_handlers;
+};
+
+}
@@ -2,21 +2,69 @@
 #include "int_controller.hpp"
 #include "io.hpp"
 #include "memory.hpp"
+#include "save_state.hpp"
+#include "scheduler.hpp"
 #include "timer.hpp"
 
 namespace gbemu::core
 {
 
-Serial::Serial(InterruptController* interrupts) :
+static constexpr size_t BIT_PERIOD =
+    Timer::SYSTEM_FREQUENCY / Serial::CLOCK_FREQUENCY;
+
+Serial::Serial(InterruptController* interrupts, Scheduler* scheduler) :
     m_interrupts(interrupts),
-    m_counter(0)
+    m_scheduler(scheduler),
+    m_counter(0),
+    m_input(0xFF), // nothing connected
+    m_sb(0),
+    m_sc{}
 {
+    m_scheduler->setHandler(EventType_Serial,
+                            Scheduler::handler<&Serial::onBitEvent>(this));
 }
 
 void Serial::mapMemory(Memory* mem)
 {
     mem->mapRW(SB_ADDR, &m_sb);
-    mem->mapRW(SC_ADDR, &m_sc);
+    mem->mapRW(
+        MmioRead(SC_ADDR, 1, &m_sc),
+        MmioWrite(SC_ADDR, 1, MmioWrite::handler<&Serial::writeSc>(this)));
+}
+
+void Serial::saveState(StateWriter& state)
+{
+    state.write(m_counter);
+    state.write(m_input);
+    state.write(m_sb);
+    state.write(m_sc);
+}
+
+void Serial::loadState(StateReader& state)
+{
+    state.read(m_counter);
+    state.read(m_input);
+    state.read(m_sb);
+    state.read(m_sc);
+}
+
+Result<void> Serial::writeSc(u16 off, u8 data)
+{
+    m_sc.shift_clock = data & 1;
+    m_sc.cgb_clock_speed = (data >> 1) & 1;
+    m_sc.transfer_flag = (data >> 7) & 1;
+
+    // only the internal clock is emulated
+    if (m_sc.transfer_flag && m_sc.shift_clock)
+    {
+        m_counter = 0;
+        m_scheduler->schedule(EventType_Serial,
+                              m_scheduler->clocks() + BIT_PERIOD);
+    }
+    else
+        m_scheduler->cancel(EventType_Serial);
+
+    return {};
 }
 
 u8 Serial::getInputBit()
@@ -24,23 +72,20 @@ u8 Serial::getInputBit()
     return (m_input >> m_counter) & 1;
 }
 
-void Serial::step(size_t clocks)
+void Serial::onBitEvent(size_t clocks)
 {
-    constexpr size_t freq = Timer::SYSTEM_FREQUENCY / CLOCK_FREQUENCY;
+    m_sb <<= 1;
+    m_sb |= getInputBit();
+    m_counter++;
 
-    if (clocks % freq == 0 && m_sc.transfer_flag)
+    if (m_counter == 8)
     {
-        m_sb <<= 1;
-        m_sb |= getInputBit();
-        m_counter++;
-
-        if (m_counter == 8)
-        {
-            m_counter = 0;
-            m_interrupts->requestInterrupt(InterruptType_Serial);
-            m_sc.transfer_flag = 0;
-        }
+        m_counter = 0;
+        m_interrupts->requestInterrupt(InterruptType_Serial);
+        m_sc.transfer_flag = 0;
     }
+    else
+        m_scheduler->schedule(EventType_Serial, clocks + BIT_PERIOD);
 }
 
 }
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "device.hpp"
+#include "result.hpp"
 
 namespace gbemu::core
 {
 
 class InterruptController;
+class Scheduler;
 
 class Serial : public Device
 {
@@ -13,16 +15,22 @@ public:
     static constexpr size_t CLOCK_FREQUENCY = 8192;
 
 public:
-    Serial(InterruptController* interrupts);
+    Serial(InterruptController* interrupts, Scheduler* scheduler);
 
     virtual void mapMemory(Memory* mem) override;
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
 
-    void step(size_t clocks);
+    Result<void> writeSc(u16 off, u8 data);
+
+    // scheduler event, shifts one bit
+    void onBitEvent(size_t clocks);
 
     u8 getInputBit();
 
 private:
     InterruptController* m_interrupts;
+    Scheduler* m_scheduler;
     size_t m_counter;
     u8 m_input;
 
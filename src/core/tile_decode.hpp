@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstring>
+#include "types.hpp"
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+namespace gbemu::core
+{
+
+// 2bpp tile decoding and palette application. The vectorized paths are picked
+// at compile time (build with NATIVE=1 to enable them), the scalar versions
+// are kept as a reference.
+
+// One tile row to 8 color codes, leftmost pixel first. The first byte gives
+// the high bit of each code.
+inline void decodeTileRowScalar(u8 b0, u8 b1, u8* dst)
+{
+    for (size_t x = 0; x < 8; x++)
+    {
+        u8 bit0 = (b0 >> (7 - x)) & 1;
+        u8 bit1 = (b1 >> (7 - x)) & 1;
+        dst[x] = (bit0 << 1) | bit1;
+    }
+}
+
+// moves each bit of `x` to the lowest bit of a byte, MSB in the first byte
+inline u64 spreadBits(u8 x)
+{
+#if defined(__BMI2__)
+    return __builtin_bswap64(_pdep_u64(x, 0x0101010101010101ull));
+#else
+    // byte i keeps bit 7 - i, then the carry of + 0x7F turns it into bit 7
+    u64 bits = (x * 0x0101010101010101ull) & 0x0102040810204080ull;
+    return ((bits + 0x7F7F7F7F7F7F7F7Full) >> 7) & 0x0101010101010101ull;
+#endif
+}
+
+// same as decodeTileRowScalar, the 8 pixels at once
+inline void decodeTileRow(u8 b0, u8 b1, u8* dst)
+{
+    u64 codes = (spreadBits(b0) << 1) | spreadBits(b1);
+    std::memcpy(dst, &codes, sizeof(codes));
+}
+
+// dst[i] = palette[indices[i]], the palette must have 16 entries
+inline void applyPaletteScalar(const u8* indices, const u32* palette,
+                               u32* dst, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        dst[i] = palette[indices[i]];
+}
+
+inline void applyPalette(const u8* indices, const u32* palette, u32* dst,
+                         size_t count)
+{
+    size_t i = 0;
+
+#if defined(__SSSE3__)
+    // one shuffle table per byte of the colors, 16 pixels per iteration
+    __m128i planes[4];
+    for (size_t k = 0; k < 4; k++)
+    {
+        u8 bytes[16];
+        for (size_t j = 0; j < 16; j++)
+            bytes[j] = palette[j] >> (k * 8);
+        planes[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+    }
+
+    for (; i + 16 <= count; i += 16)
+    {
+        __m128i idx =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+        __m128i c0 = _mm_shuffle_epi8(planes[0], idx);
+        __m128i c1 = _mm_shuffle_epi8(planes[1], idx);
+        __m128i c2 = _mm_shuffle_epi8(planes[2], idx);
+        __m128i c3 = _mm_shuffle_epi8(planes[3], idx);
+
+        // interleave the planes back into 32 bits colors
+        __m128i lo01 = _mm_unpacklo_epi8(c0, c1);
+        __m128i hi01 = _mm_unpackhi_epi8(c0, c1);
+        __m128i lo23 = _mm_unpacklo_epi8(c2, c3);
+        __m128i hi23 = _mm_unpackhi_epi8(c2, c3);
+
+        auto out = reinterpret_cast<__m128i*>(dst + i);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(lo01, lo23));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo01, lo23));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi01, hi23));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi01, hi23));
+    }
+#endif
+
+    applyPaletteScalar(indices + i, palette, dst + i, count - i);
+}
+
+}
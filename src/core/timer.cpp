@@ -1,52 +1,136 @@
 #include "timer.hpp"
+#include <algorithm>
 #include "common/logging.hpp"
 #include "int_controller.hpp"
 #include "io.hpp"
 #include "memory.hpp"
+#include "save_state.hpp"
+#include "scheduler.hpp"
 
 namespace gbemu::core
 {
 
-Timer::Timer(InterruptController* interrupt) :
+Timer::Timer(InterruptController* interrupt, Scheduler* scheduler) :
     m_interrupt(interrupt),
-    m_system_clock(0)
+    m_scheduler(scheduler),
+    m_div_reset{},
+    m_div_start(0),
+    m_system_clock(0),
+    m_div(0),
+    m_tma(0),
+    m_tima(0),
+    m_tac{}
 {
+    m_scheduler->setHandler(EventType_Timer,
+                            Scheduler::handler<&Timer::sync>(this));
 }
 
 void Timer::mapMemory(Memory* mem)
 {
-    mem->mapRW(DIV_ADDR, MmioRead::readFunc(&m_div),
-               std::bind(&Timer::resetDiv, this, std::placeholders::_1));
-    mem->mapRW(TIMA_ADDR, &m_tima);
+    mem->mapRW(
+        MmioRead(DIV_ADDR, 1, &m_div),
+        MmioWrite(DIV_ADDR, 1, MmioWrite::handler<&Timer::resetDiv>(this)));
+    mem->mapRW(
+        MmioRead(TIMA_ADDR, 1, &m_tima),
+        MmioWrite(TIMA_ADDR, 1, MmioWrite::handler<&Timer::writeTima>(this)));
     mem->mapRW(TMA_ADDR, &m_tma);
-    mem->mapRW(TAC_ADDR, &m_tac);
+    mem->mapRW(
+        MmioRead(TAC_ADDR, 1, &m_tac),
+        MmioWrite(TAC_ADDR, 1, MmioWrite::handler<&Timer::writeTac>(this)));
 }
 
-Result<void> Timer::resetDiv(u8 b)
+void Timer::saveState(StateWriter& state)
 {
+    state.write(m_div_start);
+    state.write(m_system_clock);
+    state.write(m_div);
+    state.write(m_tma);
+    state.write(m_tima);
+    state.write(m_tac);
+}
+
+void Timer::loadState(StateReader& state)
+{
+    // the overflow event is restored with the scheduler
+    state.read(m_div_start);
+    state.read(m_system_clock);
+    state.read(m_div);
+    state.read(m_tma);
+    state.read(m_tima);
+    state.read(m_tac);
+}
+
+Result<void> Timer::resetDiv(u16 off, u8 data)
+{
+    if (m_div_reset.func)
+        m_div_reset.func(m_div_reset.ctx, m_system_clock);
+
     m_div = 0;
     m_div_start = m_system_clock;
     return {};
 }
 
-void Timer::tick(size_t clocks)
+Result<void> Timer::writeTima(u16 off, u8 data)
 {
-    m_system_clock += clocks;
-    m_div = (m_div_start - m_system_clock) / (SYSTEM_FREQUENCY / DIV_FREQUENCY);
+    m_tima = data;
+    schedule();
+    return {};
+}
 
-    size_t freq = SYSTEM_FREQUENCY / TAC_FREQUENCY[m_tac.clock_select];
-    bool should_tick = m_system_clock % freq == 0;
+Result<void> Timer::writeTac(u16 off, u8 data)
+{
+    m_tac.clock_select = data & 3;
+    m_tac.timer_enable = (data >> 2) & 1;
+    schedule();
+    return {};
+}
 
-    if (m_tac.timer_enable && should_tick)
+size_t Timer::timaPeriod()
+{
+    return SYSTEM_FREQUENCY / TAC_FREQUENCY[m_tac.clock_select];
+}
+
+void Timer::schedule()
+{
+    if (!m_tac.timer_enable)
+    {
+        m_scheduler->cancel(EventType_Timer);
+        return;
+    }
+
+    // next TIMA overflow
+    size_t period = timaPeriod();
+    m_scheduler->schedule(EventType_Timer,
+                          (m_system_clock / period + 0x100 - m_tima) * period);
+}
+
+void Timer::sync(size_t clocks)
+{
+    size_t old_clocks = m_system_clock;
+    m_system_clock = std::max(clocks, old_clocks);
+    m_div = (m_system_clock - m_div_start) /
+            (SYSTEM_FREQUENCY / DIV_FREQUENCY);
+
+    if (m_tac.timer_enable)
     {
-        m_tima++;
-        // overflow
-        if (m_tima == 0)
+        size_t period = timaPeriod();
+        size_t ticks = m_system_clock / period - old_clocks / period;
+
+        while (ticks > 0)
         {
-            m_tima = m_tma;
-            m_interrupt->requestInterrupt(InterruptType_Timer);
+            size_t step = std::min<size_t>(ticks, 0x100 - m_tima);
+            ticks -= step;
+            m_tima += step;
+            // overflow
+            if (m_tima == 0)
+            {
+                m_tima = m_tma;
+                m_interrupt->requestInterrupt(InterruptType_Timer);
+            }
         }
     }
+
+    schedule();
 }
 
 }
@@ -3,6 +3,7 @@
 #include "attributes.hpp"
 #include "device.hpp"
 #include "result.hpp"
+#include "scheduler.hpp"
 
 namespace gbemu::core
 {
@@ -23,15 +24,29 @@ public:
     };
 
 public:
-    Timer(InterruptController* interrupt);
+    Timer(InterruptController* interrupt, Scheduler* scheduler);
 
-    Result<void> resetDiv(u8 b);
-    void tick(size_t clocks);
+    Result<void> resetDiv(u16 off, u8 data);
+    Result<void> writeTima(u16 off, u8 data);
+    Result<void> writeTac(u16 off, u8 data);
+
+    // catch up to the given clock, the registers are stale until then
+    void sync(size_t clocks);
+    // called with the current clock right before DIV gets reset
+    void setDivResetHandler(EventHandler handler) { m_div_reset = handler; }
     size_t systemClocks() { return m_system_clock; }
     virtual void mapMemory(Memory* mem) override;
+    virtual void saveState(StateWriter& state) override;
+    virtual void loadState(StateReader& state) override;
+
+private:
+    size_t timaPeriod();
+    void schedule();
 
 private:
     InterruptController* m_interrupt;
+    Scheduler* m_scheduler;
+    EventHandler m_div_reset;
     size_t m_div_start;
     size_t m_system_clock; // T-states
 
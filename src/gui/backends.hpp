@@ -0,0 +1,51 @@
+#pragma once
+
+#include "types.hpp"
+#include "core/audio_sink.hpp"
+#include "core/backend.hpp"
+#include "core/ppu.hpp"
+
+struct GLFWwindow;
+
+namespace gbemu::core
+{
+
+// OpenGL ES 3, must be used from the thread owning the GL context
+class GlVideoBackend : public VideoBackend
+{
+public:
+    GlVideoBackend();
+
+    virtual void present(const IndexedFrame& frame) override;
+
+private:
+    u32 m_rgba[SCREEN_WIDTH * SCREEN_HEIGHT];
+    u32 m_texture;
+    u32 m_program;
+    u32 m_vbo;
+    u32 m_texture_loc;
+};
+
+// drained by the SDL audio callback
+class SdlAudioSink : public RingAudioSink
+{
+public:
+    SdlAudioSink();
+    ~SdlAudioSink();
+
+private:
+    u32 m_device;
+};
+
+class GlfwInputBackend : public InputBackend
+{
+public:
+    GlfwInputBackend(GLFWwindow* window) : m_window(window) {}
+
+    virtual u8 poll() override;
+
+private:
+    GLFWwindow* m_window;
+};
+
+}
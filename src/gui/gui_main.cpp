@@ -2,19 +2,25 @@
 #include <GLES3/gl3.h>
 #include <GLFW/glfw3.h>
 #include <chrono>
+#include <mutex>
 #include <unordered_set>
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_glfw.h"
 #include "imgui/imgui_impl_opengl3.h"
 
 #include "types.hpp"
+#include "common/arg_parser.hpp"
 #include "common/logging.hpp"
+#include "core/apu.hpp"
 #include "core/cpu.hpp"
 #include "core/disas.hpp"
+#include "core/emu_thread.hpp"
 #include "core/gameboy.hpp"
+#include "core/joypad.hpp"
 #include "core/memory.hpp"
 #include "core/opcode.hpp"
 #include "core/ppu.hpp"
+#include "backends.hpp"
 
 static void glfw_error_callback(int error, const char* description)
 {
@@ -34,13 +40,24 @@ static void mmioRegisterInput(gbemu::core::Gameboy& gb, const char* name,
     gb.mem()->write8(gbemu::core::P1_ADDR, reg);
 }
 
-static bool s_is_running = true;
 static std::unordered_set<u16> s_breakpoints;
 
 static void drawAudio(gbemu::core::Gameboy& gb)
 {
     if (ImGui::BeginTabItem("Audio"))
     {
+        if (auto sink = gb.apu()->sink())
+        {
+            auto stats = sink->stats();
+            auto str = fmt::format("Buffered : {} / {}\nOverruns : {}\n"
+                                   "Underruns : {}",
+                                   stats.buffered, stats.target,
+                                   stats.overruns, stats.underruns);
+            ImGui::TextUnformatted(str.c_str());
+
+            ImGui::NewLine();
+        }
+
         MMIO_REG_INPUT(NR10);
         MMIO_REG_INPUT(NR11);
         MMIO_REG_INPUT(NR12);
@@ -102,7 +119,7 @@ static void drawDisassembly(gbemu::core::Gameboy& gb)
     // ImGui::EndChild();
 }
 
-static void drawBreakpoints()
+static void drawBreakpoints(gbemu::core::EmuThread& emu)
 {
     // ImGui::NextColumn();
 
@@ -127,6 +144,8 @@ static void drawBreakpoints()
     if (ImGui::Button("Add"))
     {
         s_breakpoints.insert(bp_input);
+        emu.pushEvent({ gbemu::core::EmuEventType_AddBreakpoint,
+                        static_cast<u16>(bp_input) });
 
         addresses.clear();
         names.clear();
@@ -146,6 +165,7 @@ static void drawBreakpoints()
     {
         u16 addr = addresses[selected_item];
         s_breakpoints.erase(addr);
+        emu.pushEvent({ gbemu::core::EmuEventType_RemoveBreakpoint, addr });
         addresses.erase(addresses.begin() + selected_item);
         names.erase(names.begin() + selected_item);
         names_cstr.erase(names_cstr.begin() + selected_item);
@@ -213,32 +233,42 @@ static void drawOam(gbemu::core::Gameboy& gb)
     }
 }
 
-static void drawCPU(gbemu::core::Gameboy& gb)
+static void drawCPU(gbemu::core::Gameboy& gb,
+                    gbemu::core::EmuThread& emu)
 {
     if (ImGui::BeginTabItem("CPU"))
     {
+        // emulated frames, not UI ones
         static auto last = std::chrono::system_clock::now();
+        static size_t last_frame_count = 0;
         auto now = std::chrono::system_clock::now();
         auto frame_time = std::chrono::duration<f64>(now - last).count();
-        static size_t frame_counter = 0;
-        frame_counter++;
         static f64 fps = 0.0;
         if (frame_time >= 1.0)
         {
             last = now;
-            fps = frame_counter / frame_time;
-            frame_counter = 0;
+            fps = (emu.frameCount() - last_frame_count) / frame_time;
+            last_frame_count = emu.frameCount();
         }
 
         ImGui::Text("%.2f FPS", fps);
 
-        if (ImGui::Button(s_is_running ? "Pause" : "Run"))
-            s_is_running = !s_is_running;
+        bool is_running = emu.isRunning();
+        if (ImGui::Button(is_running ? "Pause" : "Run"))
+            emu.pushEvent({ is_running ? gbemu::core::EmuEventType_Pause
+                                       : gbemu::core::EmuEventType_Run,
+                            0 });
 
         ImGui::SameLine();
 
         if (ImGui::Button("Step"))
-            gb.step();
+            emu.pushEvent({ gbemu::core::EmuEventType_Step, 0 });
+
+        ImGui::SameLine();
+
+        static bool unthrottled = false;
+        if (ImGui::Checkbox("Unthrottled", &unthrottled))
+            emu.setSpeed(unthrottled ? 0.0f : 1.0f);
 
         auto& regs = gb.cpu()->regs();
         int a = regs.a;
@@ -313,19 +343,20 @@ static void drawCPU(gbemu::core::Gameboy& gb)
             regs.flags.c = flag_c;
 
         drawDisassembly(gb);
-        drawBreakpoints();
+        drawBreakpoints(emu);
 
         ImGui::EndTabItem();
     }
 }
 
-static void drawImGui(gbemu::core::Gameboy& gb)
+static void drawImGui(gbemu::core::Gameboy& gb,
+                      gbemu::core::EmuThread& emu)
 {
     if (ImGui::Begin("Main"))
     {
         if (ImGui::BeginTabBar("Debug"))
         {
-            drawCPU(gb);
+            drawCPU(gb, emu);
             drawJoypad(gb);
             drawPpu(gb);
             drawOam(gb);
@@ -336,69 +367,89 @@ static void drawImGui(gbemu::core::Gameboy& gb)
     ImGui::End();
 }
 
-GLFWwindow* g_window;
-
-s32 gui_main(gbemu::core::Gameboy& gb)
+s32 frontend_main(gbemu::core::Gameboy& gb, ArgParser& args)
 {
     glfwSetErrorCallback(glfw_error_callback);
 
     if (!glfwInit())
         return 1;
 
-    // g_window = glfwCreateWindow(256*3, 256*3, "Gameboy", NULL, NULL);
-    g_window =
+    // window = glfwCreateWindow(256*3, 256*3, "Gameboy", NULL, NULL);
+    GLFWwindow* window =
         glfwCreateWindow(gbemu::core::SCREEN_WIDTH * 5,
                          gbemu::core::SCREEN_HEIGHT * 5, "Gameboy", NULL, NULL);
-    if (g_window == NULL)
+    if (window == NULL)
         return 1;
 
-    glfwMakeContextCurrent(g_window);
+    glfwMakeContextCurrent(window);
     glfwSwapInterval(1); // Enable vsync
 
     ImGui::CreateContext();
     ImGui::StyleColorsDark();
-    ImGui_ImplGlfw_InitForOpenGL(g_window, true);
+    ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init("#version 130");
 
+    gbemu::core::GlVideoBackend video;
+    gbemu::core::SdlAudioSink audio;
+    gbemu::core::GlfwInputBackend input(window);
+    gb.apu()->setSink(&audio);
+
+    // the emulator runs on its own thread, this loop only handles the UI
+    auto emu = std::make_unique<gbemu::core::EmuThread>(&gb);
+    emu->start();
+
+    u8 buttons = 0;
+    bool rewinding = false;
+
     // Main loop
-    while (!glfwWindowShouldClose(g_window))
+    while (!glfwWindowShouldClose(window))
     {
         glfwPollEvents();
 
-        if (s_breakpoints.contains(gb.cpu()->regs().pc))
-            s_is_running = false;
+        u8 pressed = input.poll();
+        if (pressed != buttons &&
+            emu->pushEvent({ gbemu::core::EmuEventType_Buttons, pressed }))
+            buttons = pressed;
 
-        if (s_is_running)
-            gb.step();
+        // held to rewind, unless typing in the debugger
+        bool rewind = !ImGui::GetIO().WantCaptureKeyboard &&
+                      glfwGetKey(window, GLFW_KEY_BACKSPACE) == GLFW_PRESS;
+        if (rewind != rewinding &&
+            emu->pushEvent({ gbemu::core::EmuEventType_Rewind, rewind }))
+            rewinding = rewind;
 
-        // Rendering (always render if we're not running)
-        if (gb.ppu()->newFrameAvailable() || !s_is_running)
-        {
-            ImGui_ImplOpenGL3_NewFrame();
-            ImGui_ImplGlfw_NewFrame();
-            ImGui::NewFrame();
+        emu->updateFrame();
+
+        ImGui_ImplOpenGL3_NewFrame();
+        ImGui_ImplGlfw_NewFrame();
+        ImGui::NewFrame();
 
-            drawImGui(gb);
+        {
+            std::lock_guard lock(emu->lock());
+            drawImGui(gb, *emu);
+        }
 
-            ImGui::Render();
+        ImGui::Render();
 
-            s32 display_w, display_h;
-            glfwGetFramebufferSize(g_window, &display_w, &display_h);
-            glViewport(0, 0, display_w, display_h);
-            gb.ppu()->render();
+        s32 display_w, display_h;
+        glfwGetFramebufferSize(window, &display_w, &display_h);
+        glViewport(0, 0, display_w, display_h);
+        video.present(emu->frame());
 
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
-            glfwSwapBuffers(g_window);
-        }
+        glfwSwapBuffers(window);
     }
 
+    emu->stop();
+    gb.apu()->setSink(nullptr);
+
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
 
     // Cleanup
-    glfwDestroyWindow(g_window);
+    glfwDestroyWindow(window);
     glfwTerminate();
 
     return 0;
@@ -1,37 +1,26 @@
 #include <GLFW/glfw3.h>
-#include "core/int_controller.hpp"
 #include "core/joypad.hpp"
-
-extern GLFWwindow* g_window;
+#include "backends.hpp"
 
 namespace gbemu::core
 {
 
-void Joypad::processInput()
+u8 GlfwInputBackend::poll()
 {
-    u8 old_p1 = m_p1.raw;
+    auto pressed = [this](int key)
+    { return glfwGetKey(m_window, key) == GLFW_PRESS; };
 
-    if (m_p1.select_direction == 0 && m_p1.select_button == 1)
-    {
-        m_p1.up_select = glfwGetKey(g_window, GLFW_KEY_UP) == GLFW_RELEASE;
-        m_p1.down_start = glfwGetKey(g_window, GLFW_KEY_DOWN) == GLFW_RELEASE;
-        m_p1.right_a = glfwGetKey(g_window, GLFW_KEY_RIGHT) == GLFW_RELEASE;
-        m_p1.left_b = glfwGetKey(g_window, GLFW_KEY_LEFT) == GLFW_RELEASE;
-    }
-    if (m_p1.select_button == 0 && m_p1.select_direction == 1)
-    {
-        m_p1.up_select =
-            glfwGetKey(g_window, GLFW_KEY_RIGHT_CONTROL) == GLFW_RELEASE;
-        m_p1.down_start = glfwGetKey(g_window, GLFW_KEY_SPACE) == GLFW_RELEASE;
-        m_p1.right_a = glfwGetKey(g_window, GLFW_KEY_ENTER) == GLFW_RELEASE;
-        m_p1.left_b =
-            glfwGetKey(g_window, GLFW_KEY_RIGHT_SHIFT) == GLFW_RELEASE;
-    }
+    u8 buttons = 0;
+    buttons |= pressed(GLFW_KEY_RIGHT) ? JoypadButton_Right : 0;
+    buttons |= pressed(GLFW_KEY_LEFT) ? JoypadButton_Left : 0;
+    buttons |= pressed(GLFW_KEY_UP) ? JoypadButton_Up : 0;
+    buttons |= pressed(GLFW_KEY_DOWN) ? JoypadButton_Down : 0;
+    buttons |= pressed(GLFW_KEY_ENTER) ? JoypadButton_A : 0;
+    buttons |= pressed(GLFW_KEY_RIGHT_SHIFT) ? JoypadButton_B : 0;
+    buttons |= pressed(GLFW_KEY_RIGHT_CONTROL) ? JoypadButton_Select : 0;
+    buttons |= pressed(GLFW_KEY_SPACE) ? JoypadButton_Start : 0;
 
-    if ((old_p1 & ~m_p1.raw) & 0xF)
-    {
-        m_interrupts->requestInterrupt(InterruptType_Joypad);
-    }
+    return buttons;
 }
 
 }
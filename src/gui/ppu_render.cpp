@@ -2,6 +2,7 @@
 #include "common/fs.hpp"
 #include "common/logging.hpp"
 #include "core/ppu.hpp"
+#include "backends.hpp"
 
 namespace gbemu::core
 {
@@ -48,100 +49,62 @@ static u32 compileProgram()
     return program;
 }
 
-void Ppu::render()
+GlVideoBackend::GlVideoBackend()
 {
-    static bool init = false;
-    static int i = 0;
-    // LOG("render {}\n", i++);
-    // LOG("scy={}\n", m_scy);
+    glGenTextures(1, &m_texture);
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, SCREEN_WIDTH, SCREEN_HEIGHT, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+    m_program = compileProgram();
+    m_texture_loc = glGetUniformLocation(m_program, "u_texture");
+
+    u32 tex_coord_loc = glGetAttribLocation(m_program, "pos");
+
+    static constexpr f32 tex_coords[] = {
+        // clang-format off
+        -1.0, -1.0,
+        -1.0,  1.0,
+        1.0,  1.0,
+
+        -1.0, -1.0,
+        1.0,  1.0,
+        1.0,  -1.0,
+        // clang-format on
+    };
+
+    glGenBuffers(1, &m_vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords,
+                 GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(tex_coord_loc);
+    glVertexAttribPointer(tex_coord_loc, 2, GL_FLOAT, false, 2 * sizeof(f32),
+                          nullptr);
+}
+
+void GlVideoBackend::present(const IndexedFrame& frame)
+{
+    frame.toRgba(m_rgba);
 
     glClearColor(0.1, 0.1, 0.1, 1.0);
     glClear(GL_COLOR_BUFFER_BIT);
 
-    static u32 tex = 0;
-    static u32 program = 0;
-    static u32 vbo = 0;
-    // static u32 scy_loc = 0;
-    static u32 tex_loc = 0;
-
-    // size_t tex_w = 256;
-    // size_t tex_h = 256;
-    // u32* tex_data = m_bg_texture;
-    size_t tex_w = SCREEN_WIDTH;
-    size_t tex_h = SCREEN_HEIGHT;
-    u32* tex_data = m_screen_texture;
-    // size_t tex_w = 10;
-    // size_t tex_h = 10;
-
-    // std::fill_n(tex_data, tex_w * tex_h, 0xFFFFFFFF);
-
-    // for (size_t x = 0; x < tex_w; x++)
-    //     tex_data[x] = 0xFF0000FF;
-
-    // for (size_t x = 0; x < tex_w; x++)
-    //     tex_data[(tex_h-1)*tex_w + x] = 0xFFFF0000;
+    glUniform1f(m_texture_loc, m_texture);
 
-    // for (size_t y = 0; y < tex_h; y++)
-    //     tex_data[y*tex_w] = 0xFF0000FF;
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, SCREEN_WIDTH, SCREEN_HEIGHT,
+                    GL_RGBA, GL_UNSIGNED_BYTE, m_rgba);
 
-    // for (size_t y = 0; y < tex_h; y++)
-    //     tex_data[y*tex_w+tex_w-1] = 0xFFFF0000;
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
 
-    if (!init)
-    {
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex_w, tex_h, 0, GL_RGBA,
-                     GL_UNSIGNED_BYTE, tex_data);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-        program = compileProgram();
-        tex_loc = glGetUniformLocation(program, "u_texture");
-        // scy_loc = glGetUniformLocation(program, "u_scy");
-
-        u32 tex_coord_loc = glGetAttribLocation(program, "pos");
-
-        static f32 tex_coords[] = {
-            // clang-format off
-            -1.0, -1.0,
-            -1.0,  1.0,
-            1.0,  1.0,
-
-            -1.0, -1.0,
-            1.0,  1.0,
-            1.0,  -1.0,
-            // clang-format on
-        };
-
-        glGenBuffers(1, &vbo);
-        glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(tex_coords), tex_coords,
-                     GL_STATIC_DRAW);
-
-        glEnableVertexAttribArray(tex_coord_loc);
-        glVertexAttribPointer(tex_coord_loc, 2, GL_FLOAT, false,
-                              2 * sizeof(f32), nullptr);
-
-        init = true;
-    }
-
-    glUniform1f(tex_loc, tex);
-    // glUniform1i(scy_loc, m_scy);
-
-    glBindTexture(GL_TEXTURE_2D, tex);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, tex_w, tex_h, GL_RGBA,
-                    GL_UNSIGNED_BYTE, tex_data);
-
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-    glUseProgram(program);
+    glUseProgram(m_program);
 
     glDrawArrays(GL_TRIANGLES, 0, 6);
-
-    m_new_frame_available = false;
 }
 
 }
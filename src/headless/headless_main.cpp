@@ -0,0 +1,87 @@
+#include <chrono>
+#include "types.hpp"
+#include "common/arg_parser.hpp"
+#include "common/logging.hpp"
+#include "core/apu.hpp"
+#include "core/backend.hpp"
+#include "core/capture_sink.hpp"
+#include "core/cpu.hpp"
+#include "core/gameboy.hpp"
+#include "core/joypad.hpp"
+#include "core/ppu.hpp"
+#include "core/timer.hpp"
+
+static constexpr u32 DEFAULT_FRAME_COUNT = 600;
+
+s32 frontend_main(gbemu::core::Gameboy& gb, ArgParser& args)
+{
+    using namespace gbemu::core;
+
+    u32 frame_count = DEFAULT_FRAME_COUNT;
+    if (auto frames = args.getArg("--frames"); frames && frames->value)
+        frame_count = frames->value->value_u32;
+    if (auto skip = args.getArg("--frameskip"); skip && skip->value)
+        gb.ppu()->setFrameSkip(skip->value->value_u32);
+    if (args.hasArg("--no-render"))
+        gb.ppu()->setRenderEnabled(false);
+
+    NullVideoBackend video;
+    NullAudioSink null_audio;
+    NullInputBackend input;
+
+    std::unique_ptr<CaptureAudioSink> capture;
+    fs::path path;
+    if (auto record = args.getArg("--record-audio"); record && record->value)
+    {
+        path = record->value->value;
+        auto format = path.extension() == ".raw" ? CaptureFormat_Raw
+                                                 : CaptureFormat_Wav;
+        auto sink = CaptureAudioSink::open(path, format);
+        if (!sink)
+        {
+            LOG_ERROR("Error while opening {} : {}\n", path.string(),
+                      sink.error());
+            return 1;
+        }
+        capture = std::move(sink.value());
+    }
+
+    AudioSink* audio = &null_audio;
+    if (capture)
+        audio = capture.get();
+    gb.apu()->setSink(audio);
+
+    auto start = std::chrono::steady_clock::now();
+
+    size_t clocks = gb.cpu()->clocks();
+    for (u32 i = 0; i < frame_count; i++)
+    {
+        gb.joypad()->setButtons(input.poll());
+        if (gb.runFrame() == RunResult_VBlank && gb.ppu()->isFrameRendered())
+            video.present(gb.ppu()->frame());
+    }
+    clocks = gb.cpu()->clocks() - clocks;
+
+    auto elapsed = std::chrono::duration<f64>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+    f64 emulated = static_cast<f64>(clocks) / Timer::SYSTEM_FREQUENCY;
+
+    fmt::print("{} frames in {:.3f}s ({:.1f} FPS, {:.2f}x real-time)\n",
+               frame_count, elapsed, frame_count / elapsed,
+               emulated / elapsed);
+
+    gb.apu()->setSink(nullptr);
+    if (capture)
+    {
+        if (auto ret = capture->close(); !ret)
+        {
+            LOG_ERROR("Error while writing {} : {}\n", path.string(),
+                      ret.error());
+            return 1;
+        }
+        fmt::print("{} audio samples recorded\n", capture->samplesWritten());
+    }
+
+    return 0;
+}
@@ -16,7 +16,8 @@ void printCart(gbemu::core::Cart& cart)
     fmt::print("RAM Size: {}\n", hdr->ramSize());
 }
 
-s32 gui_main(gbemu::core::Gameboy& gb);
+// implemented by each frontend (gui, headless)
+s32 frontend_main(gbemu::core::Gameboy& gb, ArgParser& args);
 
 s32 main(s32 argc, char** argv)
 {
@@ -31,6 +32,18 @@ s32 main(s32 argc, char** argv)
                        ArgParser::ArgType_StringNext, std::nullopt });
     args.registerArg({ "--bootrom", "The Bootrom",
                        ArgParser::ArgType_StringNext, std::nullopt });
+    args.registerArg({ "--frames",
+                       "Number of frames to run before exiting (headless)",
+                       ArgParser::ArgType_U32, std::nullopt });
+    args.registerArg({ "--frameskip",
+                       "Frames skipped between two drawn ones (headless)",
+                       ArgParser::ArgType_U32, std::nullopt });
+    args.registerArg({ "--no-render",
+                       "Runs without drawing any frame (headless)",
+                       ArgParser::ArgType_None, std::nullopt });
+    args.registerArg({ "--record-audio",
+                       "Streams the audio to a .wav or .raw file (headless)",
+                       ArgParser::ArgType_StringNext, std::nullopt });
 
     if (!args.parse(argc, argv))
     {
@@ -56,21 +69,24 @@ s32 main(s32 argc, char** argv)
 
     if (input.has_value())
     {
-        auto rom = File::readAllBytes(input.value().value.value().value);
-        auto cart = std::make_unique<Cart>(rom.value());
-
-        if (args.hasArg("--print-header"))
+        auto rom = File::mapReadOnly(input.value().value.value().value);
+        if (!rom)
         {
-            if (!rom)
-            {
-                LOG_ERROR("Error while opening file : {}\n", rom.error());
-                return 1;
-            }
+            LOG_ERROR("Error while opening file : {}\n", rom.error());
+            return 1;
+        }
 
-            printCart(*cart);
+        auto cart = Cart::open(std::move(rom.value()));
+        if (!cart)
+        {
+            LOG_ERROR("Invalid ROM : {}\n", cart.error());
+            return 1;
         }
 
-        gb.setCartridge(std::move(cart));
+        if (args.hasArg("--print-header"))
+            printCart(*cart.value());
+
+        gb.setCartridge(std::move(cart.value()));
     }
     else
     {
@@ -78,7 +94,5 @@ s32 main(s32 argc, char** argv)
         return 1;
     }
 
-    gui_main(gb);
-
-    return 0;
+    return frontend_main(gb, args);
 }
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "core/apu.hpp"
+#include "core/int_controller.hpp"
+#include "core/io.hpp"
+#include "core/memory.hpp"
+#include "core/scheduler.hpp"
+#include "core/timer.hpp"
+
+using namespace gbemu::core;
+
+#define APU_CREATE() \
+    Memory mem; \
+    InterruptController ints; \
+    Scheduler sched; \
+    Timer timer(&ints, &sched); \
+    Apu apu(&sched); \
+    timer.setDivResetHandler(Scheduler::handler<&Apu::onDivReset>(&apu)); \
+    timer.mapMemory(&mem); \
+    apu.mapMemory(&mem);
+
+#define SYNC(x) \
+    sched.sync(x); \
+    timer.sync(x);
+
+#define READ(addr) mem.read8(addr).value()
+#define WRITE(addr, x) ASSERT_TRUE(mem.write8(addr, x))
+
+
+TEST(apu, registers)
+{
+    APU_CREATE();
+
+    // writes are ignored while powered off
+    WRITE(NR12_ADDR, 0xF0);
+    ASSERT_EQ(READ(NR12_ADDR), 0x00);
+    ASSERT_EQ(READ(NR52_ADDR), 0x70);
+
+    WRITE(NR52_ADDR, 0x80);
+    WRITE(NR11_ADDR, 0xBF);
+    WRITE(NR12_ADDR, 0xF0);
+    // write only bits read back as 1
+    ASSERT_EQ(READ(NR11_ADDR), 0xBF);
+    ASSERT_EQ(READ(NR12_ADDR), 0xF0);
+    ASSERT_EQ(READ(NR13_ADDR), 0xFF);
+    ASSERT_EQ(READ(0xFF15), 0xFF);
+
+    WRITE(NR14_ADDR, 0x80);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF1);
+
+    // turning the DAC off disables the channel
+    WRITE(NR12_ADDR, 0x00);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF0);
+
+    // powering off clears everything
+    WRITE(NR12_ADDR, 0xF0);
+    WRITE(NR14_ADDR, 0x80);
+    WRITE(NR52_ADDR, 0x00);
+    ASSERT_EQ(READ(NR52_ADDR), 0x70);
+    ASSERT_EQ(READ(NR12_ADDR), 0x00);
+}
+
+TEST(apu, length)
+{
+    APU_CREATE();
+
+    WRITE(NR52_ADDR, 0x80);
+    WRITE(NR21_ADDR, 0x3E); // 2 steps
+    WRITE(NR22_ADDR, 0xF0);
+    WRITE(NR24_ADDR, 0xC0);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF2);
+
+    // the length is clocked every other frame sequencer step
+    SYNC(8192);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF2);
+    SYNC(8192 * 3 - 1);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF2);
+    SYNC(8192 * 3);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF0);
+}
+
+TEST(apu, div_reset)
+{
+    APU_CREATE();
+
+    WRITE(NR52_ADDR, 0x80);
+    WRITE(NR21_ADDR, 0x3E); // 2 steps
+    WRITE(NR22_ADDR, 0xF0);
+    WRITE(NR24_ADDR, 0xC0);
+
+    // resetting DIV while bit 4 is set clocks the frame sequencer early, and
+    // the next steps follow the new DIV phase
+    SYNC(0x1000);
+    WRITE(DIV_ADDR, 0);
+    SYNC(0x1000 + 8192 * 2 - 1);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF2);
+    SYNC(0x1000 + 8192 * 2);
+    ASSERT_EQ(READ(NR52_ADDR), 0xF0);
+}
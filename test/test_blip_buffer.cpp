@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "core/blip_buffer.hpp"
+
+using namespace gbemu::core;
+
+TEST(blip_buffer, step)
+{
+    // 4 clocks per sample
+    BlipBuffer blip(4 * 1000, 1000, 256);
+    s16 out[64];
+
+    blip.addDelta(40 + 1, 1000);
+    blip.endFrame(64 * 4);
+    ASSERT_EQ(blip.samplesAvailable(), 64);
+    ASSERT_EQ(blip.readSamples(out, 64), 64);
+
+    // silent before the step, settles at the step's height after it, with
+    // some ringing in between
+    for (size_t i = 0; i < 4; i++)
+        ASSERT_EQ(out[i], 0);
+    for (size_t i = 32; i < 64; i++)
+        ASSERT_EQ(out[i], 1000);
+    ASSERT_GT(out[10 + BlipBuffer::TAPS / 2], 900);
+
+    // the integrator carries over to the next frame
+    blip.addDelta(32 * 4, -1000);
+    blip.endFrame(64 * 4);
+    ASSERT_EQ(blip.readSamples(out, 64), 64);
+    ASSERT_EQ(out[0], 1000);
+    ASSERT_EQ(out[63], 0);
+}
+
+TEST(blip_buffer, sample_rate)
+{
+    BlipBuffer blip(4 * 1000, 1000, 256);
+
+    blip.endFrame(100 * 4);
+    ASSERT_EQ(blip.samplesAvailable(), 100);
+
+    blip.setSampleRate(1250);
+    blip.endFrame(100 * 4);
+    ASSERT_EQ(blip.samplesAvailable(), 100 + 125);
+}
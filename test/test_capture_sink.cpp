@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "core/capture_sink.hpp"
+
+using namespace gbemu::core;
+
+static std::vector<u8> readFile(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<u8>(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+}
+
+static u32 read32(const std::vector<u8>& data, size_t off)
+{
+    u32 x;
+    std::memcpy(&x, data.data() + off, sizeof(x));
+    return x;
+}
+
+TEST(capture_sink, wav)
+{
+    fs::path path = fs::temp_directory_path() / "gbemu_capture_test.wav";
+
+    // several times the internal buffer
+    std::vector<s16> samples(0x1000 * 2);
+    size_t blocks = 20;
+    {
+        auto sink = CaptureAudioSink::open(path, CaptureFormat_Wav);
+        ASSERT_TRUE(sink);
+
+        for (size_t i = 0; i < blocks; i++)
+        {
+            for (size_t j = 0; j < samples.size(); j++)
+                samples[j] = i * samples.size() + j;
+            sink.value()->write(samples.data(), samples.size() / 2);
+        }
+    }
+
+    auto data = readFile(path);
+    fs::remove(path);
+
+    size_t data_size = blocks * samples.size() * sizeof(s16);
+    ASSERT_EQ(data.size(), 44 + data_size);
+    ASSERT_EQ(std::memcmp(data.data(), "RIFF", 4), 0);
+    ASSERT_EQ(read32(data, 4), 36 + data_size);
+    ASSERT_EQ(read32(data, 40), data_size);
+
+    // samples are written in order
+    for (size_t i = 0; i < data_size / sizeof(s16); i++)
+    {
+        s16 sample;
+        std::memcpy(&sample, data.data() + 44 + i * sizeof(s16),
+                    sizeof(sample));
+        ASSERT_EQ(sample, static_cast<s16>(i));
+    }
+}
+
+TEST(capture_sink, raw)
+{
+    fs::path path = fs::temp_directory_path() / "gbemu_capture_test.raw";
+
+    s16 samples[] = { 1, 2, 3, 4 };
+    {
+        auto sink = CaptureAudioSink::open(path, CaptureFormat_Raw);
+        ASSERT_TRUE(sink);
+        sink.value()->write(samples, 2);
+    }
+
+    auto data = readFile(path);
+    fs::remove(path);
+
+    ASSERT_EQ(data.size(), sizeof(samples));
+    ASSERT_EQ(std::memcmp(data.data(), samples, sizeof(samples)), 0);
+}
+
+TEST(capture_sink, open_error)
+{
+    auto sink = CaptureAudioSink::open("/nonexistent/dir/file.wav",
+                                       CaptureFormat_Wav);
+    ASSERT_FALSE(sink);
+}
+
+TEST(capture_sink, write_error)
+{
+    // every write fails with ENOSPC
+    auto sink = CaptureAudioSink::open("/dev/full", CaptureFormat_Raw);
+    ASSERT_TRUE(sink);
+
+    std::vector<s16> samples(0x1000 * 2 * 8);
+    sink.value()->write(samples.data(), samples.size() / 2);
+
+    ASSERT_EQ(sink.value()->close().error(), FileSystemError_WriteFailed);
+    ASSERT_EQ(sink.value()->close().error(), FileSystemError_WriteFailed);
+    ASSERT_EQ(sink.value()->samplesWritten(), 0);
+}
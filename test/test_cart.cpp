@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "core/cart.hpp"
+#include "core/gameboy.hpp"
+#include "core/memory.hpp"
+
+using namespace gbemu::core;
+
+static std::vector<u8> makeRom(size_t size, CartridgeType type, u8 rom_size)
+{
+    std::vector<u8> rom(size);
+    for (size_t bank = 0; bank < size / ROM_BANK_SIZE; bank++)
+        rom[bank * ROM_BANK_SIZE + 0x200] = bank;
+    rom[0x147] = type;
+    rom[0x148] = rom_size;
+    return rom;
+}
+
+TEST(cart, validate)
+{
+    auto rom = makeRom(MIN_ROM_SIZE, CartridgeType_MBC1, 0);
+    ASSERT_TRUE(Cart::validate(rom));
+
+    ASSERT_EQ(Cart::validate(std::span(rom).first(512)).error(),
+              CartError_RomTooSmall);
+
+    // the header asks for 4 banks
+    rom[0x148] = 1;
+    ASSERT_EQ(Cart::validate(rom).error(), CartError_RomTooSmall);
+
+    rom[0x148] = 0x20;
+    ASSERT_EQ(Cart::validate(rom).error(), CartError_InvalidRomSize);
+
+    rom[0x148] = 0;
+    rom[0x147] = CartridgeType_MBC5;
+    ASSERT_EQ(Cart::validate(rom).error(), CartError_UnsupportedType);
+}
+
+TEST(cart, bank_wrap)
+{
+    // 4 banks as the header says, the MBC3 accepts up to 128
+    Gameboy gb;
+    ASSERT_TRUE(gb.setCartridge(std::make_unique<Cart>(
+        makeRom(4 * ROM_BANK_SIZE, CartridgeType_MBC3, 1))));
+
+    ASSERT_TRUE(gb.mem()->write8(0x2000, 3));
+    ASSERT_EQ(gb.mem()->read8(0x4200).value(), 3);
+    ASSERT_TRUE(gb.mem()->write8(0x2000, 6));
+    ASSERT_EQ(gb.mem()->read8(0x4200).value(), 2);
+
+    // truncated ROMs are padded with zeros
+    Gameboy padded;
+    ASSERT_TRUE(padded.setCartridge(std::make_unique<Cart>(
+        makeRom(MIN_ROM_SIZE, CartridgeType_MBC3, 1))));
+    ASSERT_EQ(padded.cart()->rom().size(), 4 * ROM_BANK_SIZE);
+    ASSERT_TRUE(padded.mem()->write8(0x2000, 3));
+    ASSERT_EQ(padded.mem()->read8(0x4200).value(), 0);
+}
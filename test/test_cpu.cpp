@@ -4,6 +4,8 @@
 #include "core/timer.hpp"
 #include "core/int_controller.hpp"
 #include "core/opcode.hpp"
+#include "core/scheduler.hpp"
+#include "core/optable.hpp"
 
 using namespace gbemu::core;
 
@@ -37,10 +39,11 @@ using namespace gbemu::core;
     u8 ram[0x100]; \
     Memory mem; \
     InterruptController ints; \
-    Timer timer(&ints); \
+    Scheduler sched; \
+    Timer timer(&ints, &sched); \
     mem.mapRW(0x0000, code, sizeof(code)); \
     mem.mapRW(0x1000, ram, sizeof(ram)); \
-    Cpu cpu(&mem, &timer, &ints); \
+    Cpu cpu(&mem, &timer, &ints, &sched); \
     cpu.setLogging(CPU_LOG);
 
 #define CPU_RUN() \
@@ -773,3 +776,44 @@ TEST(cpu, op_sp_s8)
     TEST_OP_SP_S8(0x00F1, 0x10, 0x0101, 0, 1);
 
 }
+
+#define TEST_OP_CYCLES(f_, ...) \
+    { \
+        CPU_CREATE(__VA_ARGS__); \
+        REG_BC = REG_DE = REG_HL = 0x1000; \
+        REG_SP = 0x1080; \
+        cpu.regs().f = f_; \
+        size_t start = cpu.clocks(); \
+        cpu.step(); \
+        cycles = cpu.clocks() - start; \
+    }
+
+TEST(cpu, op_cycles)
+{
+    for (size_t op = 0; op < 0x100; op++)
+    {
+        const OpInfo& info = OP_INFO[op];
+        if (!info.valid || op == OP_HALT || op == OP_STOP_d8 ||
+            op == OP_PREFIX)
+            continue;
+
+        // both branches should be covered by either flag state
+        size_t cycles;
+        TEST_OP_CYCLES(0x00, (u8)op, 0x00, 0x10);
+        size_t cycles_clear = cycles;
+        TEST_OP_CYCLES(0xF0, (u8)op, 0x00, 0x10);
+        size_t cycles_set = cycles;
+
+        EXPECT_EQ(std::min(cycles_clear, cycles_set), info.cycles)
+            << "opcode " << op;
+        EXPECT_EQ(std::max(cycles_clear, cycles_set), info.cycles_branch)
+            << "opcode " << op;
+    }
+
+    for (size_t op = 0; op < 0x100; op++)
+    {
+        size_t cycles;
+        TEST_OP_CYCLES(0x00, OP_PREFIX, (u8)op);
+        EXPECT_EQ(cycles, CB_OP_INFO[op].cycles) << "opcode CB " << op;
+    }
+}
@@ -0,0 +1,39 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+
+#include "common/fs.hpp"
+#include "core/cart.hpp"
+
+using namespace gbemu::core;
+
+TEST(fs, map_read_only)
+{
+    auto path = fs::temp_directory_path() / "gbemu_test_map.gb";
+
+    std::vector<u8> rom(2 * ROM_BANK_SIZE);
+    for (size_t i = 0; i < rom.size(); i++)
+        rom[i] = i * 7;
+    rom[0x147] = CartridgeType_ROM;
+    rom[0x148] = 0;
+    ASSERT_TRUE(File::writeAllBytes(path, rom.data(), rom.size()));
+
+    auto file = File::mapReadOnly(path);
+    fs::remove(path);
+    ASSERT_TRUE(file);
+    ASSERT_TRUE(std::ranges::equal(file.value()->bytes(), rom));
+
+    // the cart and its forks read from the mapping
+    auto cart = Cart::open(file.value());
+    ASSERT_TRUE(cart);
+    auto fork = cart.value()->fork();
+    ASSERT_EQ(cart.value()->rom().data(), file.value()->bytes().data());
+    ASSERT_EQ(fork->rom().data(), file.value()->bytes().data());
+
+    // the mapping outlives the file and its last user
+    file.value().reset();
+    cart.value().reset();
+    ASSERT_TRUE(std::ranges::equal(fork->rom(), rom));
+
+    ASSERT_EQ(File::mapReadOnly(path).error(),
+              FileSystemError_FileOpenFailed);
+}
@@ -157,4 +157,81 @@ TEST(memory, remap_buffer)
     ASSERT_TRUE(mem.write8(0x100, 10));
     ASSERT_EQ(mem.read8(0x100).value(), 5);
     ASSERT_EQ(buff0[0], 10);
-}
\ No newline at end of file
+}
+TEST(memory, page_table)
+{
+    Memory mem;
+    u8 bank0[0x200] = {};
+    u8 bank1[0x200] = {};
+    u8 reg = 0;
+
+    bank0[0x000] = 1;
+    bank0[0x1FF] = 2;
+    bank1[0x000] = 3;
+
+    // spans two full pages
+    ASSERT_TRUE(mem.mapRW(0x4000, bank0, sizeof(bank0)));
+    ASSERT_EQ(mem.read8(0x4000).value(), 1);
+    ASSERT_EQ(mem.read8(0x41FF).value(), 2);
+    ASSERT_TRUE(mem.write8(0x4100, 9));
+    ASSERT_EQ(bank0[0x100], 9);
+
+    // bank switch must be visible through the page table
+    ASSERT_TRUE(mem.remapRO(0x4000, bank1, sizeof(bank1)));
+    ASSERT_EQ(mem.read8(0x4000).value(), 3);
+
+    ASSERT_TRUE(mem.unmapRO(0x4000));
+    ASSERT_FALSE(mem.read8(0x4000));
+
+    // partial page and masked register share a page
+    ASSERT_TRUE(mem.mapRW(0xFF80, bank0, 0x7F));
+    ASSERT_TRUE(mem.mapRW(0xFF00, &reg, 1, 0b00110000));
+    ASSERT_TRUE(mem.write8(0xFF00, 0xFF));
+    ASSERT_EQ(reg, 0b00110000);
+    ASSERT_EQ(mem.read8(0xFF80).value(), 1);
+    ASSERT_FALSE(mem.read8(0xFFFF));
+}
+
+struct TestDevice
+{
+    Result<u8> read(u16 off) { return value + off; }
+    Result<void> write(u16 off, u8 data)
+    {
+        value = data;
+        return {};
+    }
+
+    u8 value = 0;
+};
+
+TEST(memory, handlers)
+{
+    Memory mem;
+    TestDevice dev;
+    u8 last = 0;
+
+    ASSERT_TRUE(mem.mapRW(0xFF10, MmioRead::handler<&TestDevice::read>(&dev),
+                          MmioWrite::handler<&TestDevice::write>(&dev), 2));
+    ASSERT_TRUE(mem.write8(0xFF11, 0x40));
+    ASSERT_EQ(dev.value, 0x40);
+    ASSERT_EQ(mem.read8(0xFF10).value(), 0x40);
+    ASSERT_EQ(mem.read8(0xFF11).value(), 0x41);
+
+    // std::function compatibility layer
+    ASSERT_TRUE(mem.mapRW(
+        0xFF20, [](u16 off) -> Result<u8> { return 0x12; },
+        [&last](u16 off, u8 data) -> Result<void>
+        {
+            last = data;
+            return {};
+        }));
+    ASSERT_EQ(mem.read8(0xFF20).value(), 0x12);
+    ASSERT_TRUE(mem.write8(0xFF20, 0x34));
+    ASSERT_EQ(last, 0x34);
+
+    // IO slots must follow remaps
+    ASSERT_TRUE(mem.unmapRW(0xFF10));
+    ASSERT_FALSE(mem.read8(0xFF10));
+    ASSERT_TRUE(mem.mapRW(0xFF10, &last, 1));
+    ASSERT_EQ(mem.read8(0xFF10).value(), 0x34);
+}
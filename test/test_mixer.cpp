@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+#include "core/mixer.hpp"
+
+using namespace gbemu::core;
+
+static std::vector<s16> randomSamples(std::mt19937& rng, size_t count)
+{
+    std::uniform_int_distribution<s32> dist(0, 15 * 546);
+    std::vector<s16> samples(count);
+    for (auto& s : samples)
+        s = dist(rng);
+    return samples;
+}
+
+TEST(mixer, routing)
+{
+    Mixer mixer;
+    std::vector<s16> ch[4] = {
+        std::vector<s16>(64, 800),
+        std::vector<s16>(64, 0),
+        std::vector<s16>(64, 0),
+        std::vector<s16>(64, 0),
+    };
+    const s16* channels[4] = { ch[0].data(), ch[1].data(), ch[2].data(),
+                               ch[3].data() };
+    s16 out[64 * 2];
+
+    // channel 1 on the left only at full volume
+    mixer.setRouting(0x70, 0x10);
+    mixer.mix(channels, out, 64);
+    ASSERT_EQ(out[0], 800);
+    ASSERT_EQ(out[1], 0);
+
+    // the DC offset fades out
+    for (size_t i = 1; i < 64; i++)
+    {
+        ASSERT_LT(out[i * 2], out[i * 2 - 2]);
+        ASSERT_EQ(out[i * 2 + 1], 0);
+    }
+}
+
+TEST(mixer, simd)
+{
+    std::mt19937 rng(1234);
+    std::vector<s16> ch[4];
+    const s16* channels[4];
+    for (size_t i = 0; i < 4; i++)
+    {
+        ch[i] = randomSamples(rng, 1001);
+        channels[i] = ch[i].data();
+    }
+
+    Mixer a;
+    Mixer b;
+    a.setRouting(0x35, 0xA7);
+    b.setRouting(0x35, 0xA7);
+
+    std::vector<s16> out_a(1001 * 2);
+    std::vector<s16> out_b(1001 * 2);
+    a.mix(channels, out_a.data(), 1001);
+    b.mixScalar(channels, out_b.data(), 1001);
+    ASSERT_EQ(out_a, out_b);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <new>
+#include <vector>
+#include "core/int_controller.hpp"
+#include "core/io.hpp"
+#include "core/memory.hpp"
+#include "core/ppu.hpp"
+#include "core/save_state.hpp"
+#include "core/scheduler.hpp"
+
+using namespace gbemu::core;
+
+#define PPU_CREATE() \
+    Memory mem; \
+    InterruptController ints; \
+    Scheduler sched; \
+    Ppu ppu(&ints, &sched); \
+    ints.mapMemory(&mem); \
+    ppu.mapMemory(&mem);
+
+#define WRITE(addr, x) ASSERT_TRUE(mem.write8(addr, x))
+
+static constexpr u32 WHITE = 0xFFFFFFFF;
+static constexpr u32 LIGHT = 0xFFAAAAAA;
+
+static u32 pixel(const Ppu& ppu, size_t x)
+{
+    u32 rgba[SCREEN_WIDTH * SCREEN_HEIGHT];
+    ppu.frame().toRgba(rgba);
+    return rgba[x];
+}
+
+
+TEST(ppu, bg_line)
+{
+    PPU_CREATE();
+
+    WRITE(LCDC_ADDR, 0x91); // LCD on, tiles at 0x8000, BG on
+    WRITE(BGP_ADDR, 0xE4);
+    WRITE(SCY_ADDR, 0);
+    WRITE(SCX_ADDR, 0);
+    WRITE(WY_ADDR, 0);
+    WRITE(WX_ADDR, 0);
+    // first row of tile 1 is solid, drawn at the top left
+    WRITE(VRAM_START + 0x10, 0xFF);
+    WRITE(VRAM_START + 0x1800, 1);
+
+    ppu.drawLine(0);
+    ASSERT_EQ(pixel(ppu, 0), LIGHT);
+    ASSERT_EQ(pixel(ppu, 7), LIGHT);
+    ASSERT_EQ(pixel(ppu, 8), WHITE);
+
+    // scrolling starts in the middle of the tile
+    WRITE(SCX_ADDR, 4);
+    ppu.drawLine(0);
+    ASSERT_EQ(pixel(ppu, 3), LIGHT);
+    ASSERT_EQ(pixel(ppu, 4), WHITE);
+
+    // VRAM writes update the decoded tiles
+    WRITE(VRAM_START + 0x10, 0x0F);
+    ppu.drawLine(0);
+    ASSERT_EQ(pixel(ppu, 0), LIGHT);
+    ASSERT_EQ(pixel(ppu, 3), LIGHT);
+    WRITE(VRAM_START + 0x10, 0x00);
+    ppu.drawLine(0);
+    ASSERT_EQ(pixel(ppu, 0), WHITE);
+}
+
+TEST(ppu, frame_skip)
+{
+    PPU_CREATE();
+
+    // start of the VBlank of the nth frame
+    auto vblank = [](size_t n)
+    { return FRAME_CYCLES * n + LINE_CYCLES * SCREEN_HEIGHT; };
+
+    WRITE(LCDC_ADDR, 0x91);
+    WRITE(BGP_ADDR, 0xE4);
+    WRITE(SCY_ADDR, 0);
+    WRITE(SCX_ADDR, 0);
+    WRITE(VRAM_START + 0x10, 0xFF);
+    WRITE(VRAM_START + 0x1800, 1);
+
+    // every other frame is drawn, with the same timings
+    ppu.setFrameSkip(1);
+    sched.sync(vblank(0));
+    ASSERT_EQ(ppu.frameCount(), 1);
+    ASSERT_TRUE(ppu.isFrameRendered());
+    ASSERT_EQ(pixel(ppu, 0), LIGHT);
+
+    WRITE(VRAM_START + 0x10, 0x00);
+    sched.sync(vblank(1));
+    ASSERT_EQ(ppu.frameCount(), 2);
+    ASSERT_FALSE(ppu.isFrameRendered());
+    ASSERT_EQ(pixel(ppu, 0), LIGHT);
+
+    sched.sync(vblank(2));
+    ASSERT_EQ(ppu.frameCount(), 3);
+    ASSERT_TRUE(ppu.isFrameRendered());
+    ASSERT_EQ(pixel(ppu, 0), WHITE);
+}
+
+TEST(ppu, map_texture_dirty)
+{
+    PPU_CREATE();
+
+    WRITE(LCDC_ADDR, 0x91);
+    WRITE(BGP_ADDR, 0xE4);
+    ASSERT_EQ(ppu.drawTiles(true), 32 * 32);
+    ASSERT_EQ(ppu.drawTiles(true), 0);
+
+    // only the entry that changed
+    WRITE(VRAM_START + 0x1800 + 5, 1);
+    ASSERT_EQ(ppu.drawTiles(true), 1);
+
+    // every entry using the tile
+    WRITE(VRAM_START + 0x1800 + 6, 1);
+    WRITE(VRAM_START + 0x10, 0xFF);
+    ASSERT_EQ(ppu.drawTiles(true), 2);
+    ASSERT_EQ(ppu.bgTexture()[5 * 8], LIGHT);
+    ASSERT_EQ(ppu.bgTexture()[4 * 8], WHITE);
+
+    // the other map isn't shown
+    WRITE(VRAM_START + 0x1C00, 1);
+    ASSERT_EQ(ppu.drawTiles(true), 0);
+
+    WRITE(BGP_ADDR, 0x1B);
+    ASSERT_EQ(ppu.drawTiles(true), 32 * 32);
+}
+
+static std::vector<u8> powerOnState(u8 fill)
+{
+    InterruptController ints;
+    Scheduler sched;
+    // constructed over garbage so that uninitialized members show up
+    alignas(Ppu) static u8 storage[sizeof(Ppu)];
+    std::memset(storage, fill, sizeof(storage));
+    auto ppu = new (storage) Ppu(&ints, &sched);
+
+    StateWriter size;
+    ppu->saveState(size);
+    std::vector<u8> state(size.size());
+    StateWriter writer(state);
+    ppu->saveState(writer);
+
+    ppu->~Ppu();
+    return state;
+}
+
+TEST(ppu, power_on_state)
+{
+    ASSERT_EQ(powerOnState(0x00), powerOnState(0xFF));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "core/cart.hpp"
+#include "core/gameboy.hpp"
+#include "core/rewind.hpp"
+#include "test_utils.hpp"
+
+using namespace gbemu::core;
+
+TEST(rewind, history)
+{
+    GB_CREATE(gb);
+    RewindBuffer rewind(1024 * 1024, 1);
+
+    std::vector<std::vector<u8>> states;
+    for (size_t i = 0; i < 20; i++)
+    {
+        gb.runFrame();
+        rewind.onFrame(&gb);
+        states.push_back(saveTestState(gb));
+    }
+    ASSERT_EQ(rewind.count(), 20);
+
+    // newest first
+    for (size_t i = 20; i-- > 0;)
+    {
+        ASSERT_TRUE(rewind.rewind(&gb));
+        ASSERT_EQ(saveTestState(gb), states[i]);
+    }
+    ASSERT_EQ(rewind.count(), 0);
+    ASSERT_FALSE(rewind.rewind(&gb));
+    ASSERT_EQ(saveTestState(gb), states[0]);
+
+    // starts over from there
+    gb.runFrame();
+    rewind.onFrame(&gb);
+    ASSERT_EQ(rewind.count(), 1);
+}
+
+TEST(rewind, ring)
+{
+    static constexpr size_t CAPACITY = 16 * 1024;
+
+    GB_CREATE(gb);
+    RewindBuffer rewind(CAPACITY, 2);
+
+    std::vector<std::vector<u8>> states;
+    for (size_t i = 0; i < 200; i++)
+    {
+        gb.runFrame();
+        rewind.onFrame(&gb);
+        if (i % 2 == 1)
+            states.push_back(saveTestState(gb));
+
+        ASSERT_LE(rewind.used(), CAPACITY);
+    }
+
+    // the oldest states were dropped
+    size_t count = rewind.count();
+    ASSERT_GT(count, 1);
+    ASSERT_LT(count, states.size());
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT_TRUE(rewind.rewind(&gb));
+        ASSERT_EQ(saveTestState(gb), states[states.size() - 1 - i]);
+    }
+    ASSERT_FALSE(rewind.rewind(&gb));
+}
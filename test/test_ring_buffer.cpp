@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+#include "common/ring_buffer.hpp"
+
+TEST(ring_buffer, wrap_around)
+{
+    RingBuffer<u32> ring(6);
+    ASSERT_EQ(ring.capacity(), 8);
+
+    u32 in[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    u32 out[8] = { 0 };
+
+    ASSERT_EQ(ring.write(in, 6), 6);
+    ASSERT_EQ(ring.read(out, 4), 4);
+    ASSERT_EQ(ring.size(), 2);
+
+    // only 6 slots left, the write wraps around the end of the storage
+    ASSERT_EQ(ring.write(in, 8), 6);
+    ASSERT_EQ(ring.size(), 8);
+    ASSERT_EQ(ring.write(in, 1), 0);
+
+    ASSERT_EQ(ring.read(out, 8), 8);
+    u32 expected[8] = { 4, 5, 0, 1, 2, 3, 4, 5 };
+    for (size_t i = 0; i < 8; i++)
+        ASSERT_EQ(out[i], expected[i]);
+    ASSERT_EQ(ring.read(out, 1), 0);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "core/cart.hpp"
+#include "core/cpu.hpp"
+#include "core/gameboy.hpp"
+#include "core/joypad.hpp"
+#include "core/save_state.hpp"
+#include "test_utils.hpp"
+
+using namespace gbemu::core;
+
+TEST(save_state, restore)
+{
+    GB_CREATE(gb);
+
+    // still in the bootrom
+    auto start = saveTestState(gb);
+    runFrames(gb, 10);
+    auto middle = saveTestState(gb);
+    runFrames(gb, 10);
+    auto end = saveTestState(gb);
+    ASSERT_EQ(start.size(), end.size());
+    ASSERT_NE(middle, end);
+
+    // both replay to the exact same state
+    ASSERT_TRUE(gb.loadState(middle));
+    runFrames(gb, 10);
+    ASSERT_EQ(saveTestState(gb), end);
+
+    ASSERT_TRUE(gb.loadState(start));
+    ASSERT_EQ(gb.cpu()->regs().pc, 0);
+    runFrames(gb, 20);
+    ASSERT_EQ(saveTestState(gb), end);
+}
+
+TEST(save_state, invalid)
+{
+    GB_CREATE(gb);
+    runFrames(gb, 1);
+    auto state = saveTestState(gb);
+
+    std::vector<u8> small(state.size() - 1);
+    ASSERT_EQ(gb.saveState(small).error(), StateError_BufferTooSmall);
+    ASSERT_EQ(gb.loadState(std::span(state).first(state.size() - 1)).error(),
+              StateError_InvalidHeader);
+
+    auto bad = state;
+    bad[0] ^= 0xFF;
+    ASSERT_EQ(gb.loadState(bad).error(), StateError_InvalidHeader);
+
+    bad = state;
+    bad[4] = SAVE_STATE_VERSION + 1;
+    ASSERT_EQ(gb.loadState(bad).error(), StateError_UnsupportedVersion);
+
+    Gameboy other;
+    ASSERT_TRUE(other.setCartridge(makeTestCart(0x34)));
+    ASSERT_EQ(other.loadState(state).error(), StateError_CartMismatch);
+
+    // nothing was touched
+    runFrames(gb, 1);
+    auto next = saveTestState(gb);
+    ASSERT_TRUE(gb.loadState(state));
+    runFrames(gb, 1);
+    ASSERT_EQ(saveTestState(gb), next);
+}
+
+TEST(save_state, fork)
+{
+    GB_CREATE(gb);
+    runFrames(gb, 5);
+
+    auto ret = gb.fork();
+    ASSERT_TRUE(ret);
+    auto fork = std::move(ret.value());
+    ASSERT_EQ(fork->cart()->rom().data(), gb.cart()->rom().data());
+    ASSERT_EQ(saveTestState(*fork), saveTestState(gb));
+
+    runFrames(gb, 10);
+    runFrames(*fork, 10);
+    ASSERT_EQ(saveTestState(*fork), saveTestState(gb));
+
+    // nothing is shared but the ROM
+    fork->joypad()->setButtons(JoypadButton_A);
+    ASSERT_NE(saveTestState(*fork), saveTestState(gb));
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "core/scheduler.hpp"
+
+using namespace gbemu::core;
+
+struct TestDevice
+{
+    Scheduler* sched;
+    EventType type;
+    size_t period;
+    std::vector<std::pair<EventType, size_t>>* log;
+
+    void onEvent(size_t clocks)
+    {
+        log->push_back({ type, clocks });
+        if (period)
+            sched->schedule(type, clocks + period);
+    }
+};
+
+
+TEST(scheduler, order)
+{
+    Scheduler sched;
+    std::vector<std::pair<EventType, size_t>> log;
+
+    TestDevice ppu{ &sched, EventType_Ppu, 100, &log };
+    TestDevice timer{ &sched, EventType_Timer, 0, &log };
+    sched.setHandler(EventType_Ppu,
+                     Scheduler::handler<&TestDevice::onEvent>(&ppu));
+    sched.setHandler(EventType_Timer,
+                     Scheduler::handler<&TestDevice::onEvent>(&timer));
+
+    ASSERT_EQ(sched.nextEvent(), Scheduler::NEVER);
+
+    sched.schedule(EventType_Ppu, 100);
+    sched.schedule(EventType_Timer, 150);
+    ASSERT_EQ(sched.nextEvent(), 100);
+
+    sched.sync(99);
+    ASSERT_TRUE(log.empty());
+    ASSERT_EQ(sched.clocks(), 99);
+
+    sched.sync(250);
+    ASSERT_EQ(log.size(), 3);
+    ASSERT_EQ(log[0], std::make_pair(EventType_Ppu, (size_t)100));
+    ASSERT_EQ(log[1], std::make_pair(EventType_Timer, (size_t)150));
+    ASSERT_EQ(log[2], std::make_pair(EventType_Ppu, (size_t)200));
+    ASSERT_EQ(sched.nextEvent(), 300);
+    ASSERT_EQ(sched.deadline(EventType_Timer), Scheduler::NEVER);
+    ASSERT_EQ(sched.clocks(), 250);
+
+    // rescheduling the nearest event later
+    sched.schedule(EventType_Timer, 280);
+    sched.schedule(EventType_Timer, 400);
+    ASSERT_EQ(sched.nextEvent(), 300);
+    sched.cancel(EventType_Ppu);
+    ASSERT_EQ(sched.nextEvent(), 400);
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "common/spsc_queue.hpp"
+
+TEST(spsc_queue, push_pop)
+{
+    SpscQueue<u32, 4> queue;
+
+    ASSERT_TRUE(queue.empty());
+    ASSERT_FALSE(queue.pop().has_value());
+
+    for (u32 i = 0; i < 4; i++)
+        ASSERT_TRUE(queue.push(i));
+    ASSERT_FALSE(queue.push(4));
+
+    ASSERT_EQ(queue.pop(), 0);
+    ASSERT_TRUE(queue.push(4));
+    for (u32 i = 1; i < 5; i++)
+        ASSERT_EQ(queue.pop(), i);
+    ASSERT_TRUE(queue.empty());
+}
+
+TEST(spsc_queue, threaded)
+{
+    static constexpr u32 COUNT = 10000;
+    SpscQueue<u32, 16> queue;
+
+    std::thread producer(
+        [&]
+        {
+            for (u32 i = 0; i < COUNT; i++)
+                while (!queue.push(i))
+                    std::this_thread::yield();
+        });
+
+    for (u32 expected = 0; expected < COUNT;)
+    {
+        auto value = queue.pop();
+        if (!value)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(*value, expected++);
+    }
+
+    producer.join();
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "common/thread_pool.hpp"
+
+TEST(thread_pool, run_all)
+{
+    static constexpr size_t COUNT = 1000;
+    ThreadPool pool(4);
+    ASSERT_EQ(pool.threadCount(), 4);
+
+    std::vector<std::atomic<u32>> runs(COUNT);
+    for (size_t i = 0; i < COUNT; i++)
+        pool.submit([&runs, i] { runs[i]++; });
+    pool.wait();
+
+    for (size_t i = 0; i < COUNT; i++)
+        ASSERT_EQ(runs[i], 1);
+
+    // still usable once idle
+    std::atomic<u32> count = 0;
+    pool.submit([&] { count++; });
+    pool.wait();
+    ASSERT_EQ(count, 1);
+}
+
+TEST(thread_pool, steal)
+{
+    ThreadPool pool(2);
+
+    // one worker is stuck on the first task until the last one runs, which
+    // is queued round-robin behind it unless that worker had stolen it
+    std::atomic<bool> started = false;
+    std::atomic<bool> released = false;
+    std::thread::id blocked_thread, stolen_thread;
+
+    pool.submit(
+        [&]
+        {
+            blocked_thread = std::this_thread::get_id();
+            started = true;
+            while (!released)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        });
+    while (!started)
+        std::this_thread::yield();
+
+    pool.submit([] {});
+    pool.submit(
+        [&]
+        {
+            stolen_thread = std::this_thread::get_id();
+            released = true;
+        });
+    pool.wait();
+
+    ASSERT_NE(stolen_thread, blocked_thread);
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "core/tile_decode.hpp"
+
+using namespace gbemu::core;
+
+TEST(tile_decode, decode)
+{
+    for (u32 b0 = 0; b0 < 0x100; b0++)
+    {
+        for (u32 b1 = 0; b1 < 0x100; b1++)
+        {
+            u8 expected[8];
+            u8 codes[8];
+            decodeTileRowScalar(b0, b1, expected);
+            decodeTileRow(b0, b1, codes);
+            ASSERT_EQ(std::memcmp(codes, expected, sizeof(codes)), 0)
+                << b0 << " " << b1;
+        }
+    }
+
+    u8 codes[8];
+    decodeTileRow(0b10100000, 0b11000000, codes);
+    ASSERT_EQ(codes[0], 3);
+    ASSERT_EQ(codes[1], 1);
+    ASSERT_EQ(codes[2], 2);
+    ASSERT_EQ(codes[3], 0);
+}
+
+TEST(tile_decode, palette)
+{
+    u32 palette[16];
+    for (size_t i = 0; i < 16; i++)
+        palette[i] = 0x01020304 * (i + 1);
+
+    // not a multiple of the vector size
+    u8 indices[37];
+    for (size_t i = 0; i < sizeof(indices); i++)
+        indices[i] = (i * 7) % 16;
+
+    u32 expected[37];
+    u32 colors[37];
+    applyPaletteScalar(indices, palette, expected, 37);
+    applyPalette(indices, palette, colors, 37);
+    for (size_t i = 0; i < 37; i++)
+    {
+        ASSERT_EQ(colors[i], palette[indices[i]]);
+        ASSERT_EQ(colors[i], expected[i]);
+    }
+}
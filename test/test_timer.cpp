@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "core/int_controller.hpp"
+#include "core/io.hpp"
+#include "core/memory.hpp"
+#include "core/scheduler.hpp"
+#include "core/timer.hpp"
+
+using namespace gbemu::core;
+
+#define TIMER_CREATE() \
+    Memory mem; \
+    InterruptController ints; \
+    Scheduler sched; \
+    Timer timer(&ints, &sched); \
+    ints.mapMemory(&mem); \
+    timer.mapMemory(&mem);
+
+#define READ(addr) mem.read8(addr).value()
+#define WRITE(addr, x) ASSERT_TRUE(mem.write8(addr, x))
+
+
+TEST(timer, div)
+{
+    TIMER_CREATE();
+
+    timer.sync(255);
+    ASSERT_EQ(READ(DIV_ADDR), 0);
+    timer.sync(256 * 3);
+    ASSERT_EQ(READ(DIV_ADDR), 3);
+
+    WRITE(DIV_ADDR, 0xAB);
+    ASSERT_EQ(READ(DIV_ADDR), 0);
+    timer.sync(256 * 4);
+    ASSERT_EQ(READ(DIV_ADDR), 1);
+}
+
+TEST(timer, tima)
+{
+    TIMER_CREATE();
+
+    // disabled
+    timer.sync(0x1000);
+    ASSERT_EQ(READ(TIMA_ADDR), 0);
+    ASSERT_EQ(sched.deadline(EventType_Timer), Scheduler::NEVER);
+
+    // 16 T-states per increment
+    WRITE(TMA_ADDR, 0x80);
+    WRITE(TIMA_ADDR, 0xFD);
+    WRITE(TAC_ADDR, 0x05);
+    ASSERT_EQ(sched.deadline(EventType_Timer), 0x1000 + 3 * 16);
+
+    timer.sync(0x1000 + 2 * 16 + 15);
+    ASSERT_EQ(READ(TIMA_ADDR), 0xFF);
+    ASSERT_EQ(READ(IF_ADDR) & (1 << InterruptType_Timer), 0);
+
+    timer.sync(0x1000 + 3 * 16);
+    ASSERT_EQ(READ(TIMA_ADDR), 0x80);
+    ASSERT_NE(READ(IF_ADDR) & (1 << InterruptType_Timer), 0);
+    ASSERT_EQ(sched.deadline(EventType_Timer), 0x1000 + 3 * 16 + 0x80 * 16);
+
+    // several overflows at once
+    timer.sync(0x1000 + 3 * 16 + 0x80 * 16 * 2 + 5 * 16);
+    ASSERT_EQ(READ(TIMA_ADDR), 0x85);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include "common/triple_buffer.hpp"
+
+TEST(triple_buffer, publish)
+{
+    TripleBuffer<u32> buffer;
+
+    ASSERT_FALSE(buffer.update());
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+
+    // only the latest frame is seen
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(buffer.readBuffer(), 2);
+    ASSERT_FALSE(buffer.update());
+    ASSERT_EQ(buffer.readBuffer(), 2);
+
+    buffer.writeBuffer() = 3;
+    buffer.publish();
+    ASSERT_TRUE(buffer.update());
+    ASSERT_EQ(buffer.readBuffer(), 3);
+}
+
+TEST(triple_buffer, threaded)
+{
+    static constexpr u32 COUNT = 10000;
+    struct Frame
+    {
+        u32 a;
+        u32 b;
+    };
+    TripleBuffer<Frame> buffer;
+
+    std::thread producer(
+        [&]
+        {
+            for (u32 i = 1; i <= COUNT; i++)
+            {
+                buffer.writeBuffer() = { i, ~i };
+                buffer.publish();
+            }
+        });
+
+    // frames are never torn and never go backwards
+    u32 last = 0;
+    while (last != COUNT)
+    {
+        if (!buffer.update())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const Frame& frame = buffer.readBuffer();
+        ASSERT_EQ(frame.b, ~frame.a);
+        ASSERT_GT(frame.a, last);
+        last = frame.a;
+    }
+
+    producer.join();
+}
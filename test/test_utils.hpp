@@ -0,0 +1,62 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "core/cart.hpp"
+#include "core/gameboy.hpp"
+
+namespace gbemu::core
+{
+
+// turns the LCD and a pulse channel on, leaves the bootrom (all NOPs) and
+// keeps filling VRAM
+static const u8 TEST_PROGRAM[] = {
+    0x3E, 0x80, 0xE0, 0x26, // NR52 = 0x80
+    0x3E, 0xF0, 0xE0, 0x12, // NR12 = 0xF0
+    0x3E, 0x87, 0xE0, 0x14, // NR14 = 0x87
+    0x3E, 0x91, 0xE0, 0x40, // LCDC = 0x91
+    0x3E, 0xE4, 0xE0, 0x47, // BGP = 0xE4
+    0x3E, 0x01, 0xE0, 0x50, // BOOT = 1
+    0x21, 0x00, 0x80,       // LD HL, 0x8000
+    0x04,                   // INC B
+    0x78,                   // LD A, B
+    0x22,                   // LD (HL+), A
+    0x7C,                   // LD A, H
+    0xFE, 0xA0,             // CP 0xA0
+    0x20, 0xF8,             // JR NZ, -8
+    0x18, 0xF3,             // JR -13
+};
+
+// ROM-only cartridge running TEST_PROGRAM
+static inline std::unique_ptr<Cart> makeTestCart(u8 checksum = 0)
+{
+    std::vector<u8> rom(2 * ROM_BANK_SIZE);
+    std::copy(std::begin(TEST_PROGRAM), std::end(TEST_PROGRAM),
+              rom.begin() + 0x100);
+    rom[0x14E] = checksum;
+    return std::make_unique<Cart>(rom);
+}
+
+static inline std::vector<u8> saveTestState(Gameboy& gb)
+{
+    std::vector<u8> state(gb.stateSize());
+    auto ret = gb.saveState(state);
+    EXPECT_TRUE(ret);
+    EXPECT_EQ(ret.value_or(0), state.size());
+    return state;
+}
+
+static inline void runFrames(Gameboy& gb, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        gb.runFrame();
+}
+
+}
+
+#define GB_CREATE(gb) \
+    Gameboy gb; \
+    ASSERT_TRUE(gb.setCartridge(makeTestCart(0x12))); \
+    ASSERT_TRUE(gb.powerOn());
@@ -1,45 +1,77 @@
 #! /usr/bin/env python3
 import argparse
+import contextlib
 import json
 
-import argparse
-
-
-def gen_disas_code(table):
-    print("switch(op)")
-    print("{")
-    print()
-
-    for op in table["unprefixed"]:
-        if (table["unprefixed"][op]["mnemonic"].startswith("ILLEGAL")):
-            continue
-        gen_disas_code_instr(table["unprefixed"][op])
-
-    print()
-    print("    default:")
-    print("        UNIMPLEMENTED(\"Invalid opcode (0x{:02X})\", op);")
-    print("}")
 
-def gen_disas_code_instr(instr):
+def disas_fmt(instr):
     disas : str = disas_instr(instr)
-    suffix = None
+    operand = "NONE"
     if "a16" in disas or "d16" in disas:
         disas = disas.replace("d16", "a16")
         disas = disas.replace("a16", "${:04X}")
-        suffix = ", read16()"
+        operand = "IMM16"
     if "a8" in disas or "d8" in disas or "r8" in disas or "s8" in disas:
         disas = disas.replace("d8", "a8")
         disas = disas.replace("r8", "a8")
         disas = disas.replace("s8", "a8")
         disas = disas.replace("a8", "${:02X}")
-        suffix = ", read8()"
+        operand = "IMM8"
+
+    return disas, operand
+
+
+def flag_effect(effect):
+    if effect == "-":
+        return "KEEP"
+    if effect == "0":
+        return "RESET"
+    if effect == "1":
+        return "SET"
+    return "UPDATE"
+
+
+def gen_optable_entry(op, instr):
+    if instr["mnemonic"].startswith("ILLEGAL"):
+        return "ILLEGAL(" + op + ")"
+
+    # conditional instructions list the taken branch first
+    cycles = instr["cycles"]
+    cycles_branch = cycles[0]
+    cycles_base = cycles[-1]
+
+    flags = instr["flags"]
+    disas, operand = disas_fmt(instr)
+
+    line = "OPCODE(" + op
+    line += ", " + op_name(instr)
+    line += ", " + str(instr["bytes"])
+    line += ", " + str(cycles_base)
+    line += ", " + str(cycles_branch)
+    for f in ["Z", "N", "H", "C"]:
+        line += ", " + flag_effect(flags[f])
+    line += ", " + operand
+    line += ", \"" + disas + "\")"
+    return line
 
-    if suffix:
-        disas = "fmt::format(\"" + disas + "\"" + suffix + ")"
-    else:
-        disas = "\"" + disas + "\""
 
-    print("    case OP_" + op_name(instr) + ": return " + disas + ";")
+def gen_optable_list(name, args, table):
+    print("#define " + name + "(" + args + ") \\")
+    for op in table:
+        print("    " + gen_optable_entry(op, table[op]) + " \\")
+    print()
+
+
+def gen_optable_header(table):
+    print("// generated by tools/optable_gen.py, do not edit")
+    print("#pragma once")
+    print("// clang-format off")
+    print()
+    print("// OPCODE(op, name, size, cycles, cycles_branch, z, n, h, c, operand, disas)")
+    print("// ILLEGAL(op)")
+    gen_optable_list("OPTABLE_UNPREFIXED", "OPCODE, ILLEGAL", table["unprefixed"])
+    gen_optable_list("OPTABLE_CBPREFIXED", "OPCODE", table["cbprefixed"])
+    print("// clang-format on")
 
 
 def disas_instr(instr):
@@ -135,19 +167,27 @@ def gen_opcode_header(table):
     print()
     print("#undef MAKE_OP")
     print()
-    print("clang-format on")
+    print("// clang-format on")
 
 def main():
     parser = argparse.ArgumentParser()
+    parser.add_argument("kind", choices=["optable", "opcodes"])
     parser.add_argument("json")
+    parser.add_argument("-o", "--output")
     args = parser.parse_args()
 
     with open(args.json) as f:
         text = f.read()
 
     table = json.loads(text)
-    # gen_opcode_header(table)
-    gen_disas_code(table)
+
+    gen = gen_optable_header if args.kind == "optable" else gen_opcode_header
+
+    if args.output:
+        with open(args.output, "w") as f, contextlib.redirect_stdout(f):
+            gen(table)
+    else:
+        gen(table)
 
 if __name__ == "__main__":
-   main()
\ No newline at end of file
+   main()